@@ -18,6 +18,9 @@ cmake_print_variables(TC_ENABLE_BENCHMARKS)
 option(TC_ENABLE_EXAMPLES "Enable Examples" True)
 cmake_print_variables(TC_ENABLE_EXAMPLES)
 
+option(TC_ENABLE_QUEUE_STATS "Enable Queues Instrumentation Counters" False)
+cmake_print_variables(TC_ENABLE_QUEUE_STATS)
+
 option(TC_ENABLE_WARNINGS_ERROR "Enable treat Warnings as Errors" True)
 cmake_print_variables(TC_ENABLE_WARNINGS_ERROR)
 
@@ -56,6 +56,7 @@ class TeiaCareSDK(ConanFile):
         tc.variables["TC_ENABLE_UNIT_TESTS_COVERAGE"] = False
         tc.variables["TC_ENABLE_BENCHMARKS"] = False
         tc.variables["TC_ENABLE_EXAMPLES"] = False
+        tc.variables["TC_ENABLE_QUEUE_STATS"] = False
         tc.variables["TC_ENABLE_WARNINGS_ERROR"] = True
         tc.variables["TC_ENABLE_SANITIZER_ADDRESS"] = False
         tc.variables["TC_ENABLE_SANITIZER_THREAD"] = False
@@ -0,0 +1,54 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "allocation_counter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+std::atomic<uint64_t> global_allocations_count{0};
+}
+
+namespace tc::sdk::benchmarks
+{
+uint64_t allocations_count()
+{
+    return global_allocations_count.load();
+}
+
+}
+
+// Replaceable allocation functions: array and nothrow variants are implemented by the standard library on top of these.
+void* operator new(std::size_t size)
+{
+    global_allocations_count.fetch_add(1, std::memory_order_relaxed);
+
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
@@ -0,0 +1,27 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+namespace tc::sdk::benchmarks
+{
+/*
+Number of heap allocations performed by the whole benchmark process.
+The global operator new is replaced in allocation_counter.cpp, so that benchmarks can report allocations per operation.
+*/
+uint64_t allocations_count();
+
+}
@@ -0,0 +1,74 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "benchmark_blocking_queue.hpp"
+
+namespace tc::sdk::benchmarks
+{
+// 1P1C, NP1C, 1PNC and NPNC throughput, with queue capacities from 1 to 64k items.
+static void throughput_args(benchmark::internal::Benchmark* b)
+{
+    b->ArgsProduct({{1, 4}, {1, 4}, {1, 16, 1024, 65536}})
+        ->ArgNames({"producers", "consumers", "capacity"})
+        ->UseRealTime()
+        ->ReportAggregatesOnly(false)
+        ->DisplayAggregatesOnly(false);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE_DEFINE_F(benchmark_blocking_queue, throughput_small_payload, int)
+(benchmark::State& state)
+{
+    producers_consumers(state);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_REGISTER_F(benchmark_blocking_queue, throughput_small_payload)
+    ->Apply(throughput_args);
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE_DEFINE_F(benchmark_blocking_queue, throughput_large_payload, large_payload)
+(benchmark::State& state)
+{
+    producers_consumers(state);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_REGISTER_F(benchmark_blocking_queue, throughput_large_payload)
+    ->Apply(throughput_args);
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE_DEFINE_F(benchmark_blocking_queue, ping_pong_small_payload, int)
+(benchmark::State& state)
+{
+    ping_pong(state);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_REGISTER_F(benchmark_blocking_queue, ping_pong_small_payload)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE_DEFINE_F(benchmark_blocking_queue, ping_pong_large_payload, large_payload)
+(benchmark::State& state)
+{
+    ping_pong(state);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_REGISTER_F(benchmark_blocking_queue, ping_pong_large_payload)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+}
@@ -0,0 +1,139 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <teiacare/sdk/blocking_queue.hpp>
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace tc::sdk::benchmarks
+{
+/*
+Large payload type: moving it is cheap (pointer swap), copying it is expensive (16 KiB memcpy + allocation).
+*/
+using large_payload = std::vector<std::byte>;
+
+template <typename T>
+class benchmark_blocking_queue : public benchmark::Fixture
+{
+public:
+    void SetUp(benchmark::State& st) override
+    {
+    }
+    void TearDown(benchmark::State& st) override
+    {
+    }
+
+protected:
+    static constexpr bool is_large_payload = std::is_same_v<T, large_payload>;
+    static constexpr size_t items_count = is_large_payload ? 1 << 11 : 1 << 14;
+    static constexpr size_t large_payload_size = 16 * 1024;
+
+    static T make_item(size_t i)
+    {
+        if constexpr (is_large_payload)
+            return large_payload(large_payload_size, static_cast<std::byte>(i));
+        else
+            return static_cast<T>(i);
+    }
+
+    void producers_consumers(benchmark::State& state)
+    {
+        const auto producers_count = static_cast<size_t>(state.range(0));
+        const auto consumers_count = static_cast<size_t>(state.range(1));
+        const auto queue_capacity = static_cast<size_t>(state.range(2));
+
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+
+            tc::sdk::blocking_queue<T> q(queue_capacity);
+
+            // Items are created (and destroyed) outside of the measured section,
+            // so that only the transfer through the queue is benchmarked.
+            std::vector<std::vector<T>> producers_items(producers_count);
+            for (size_t p = 0; p < producers_count; ++p)
+            {
+                producers_items[p].reserve(items_count / producers_count);
+                for (size_t i = 0; i < items_count / producers_count; ++i)
+                    producers_items[p].emplace_back(make_item(i));
+            }
+
+            std::vector<std::vector<T>> consumers_items(consumers_count);
+            for (auto&& items : consumers_items)
+                items.reserve(items_count / consumers_count);
+
+            state.ResumeTiming();
+
+            std::vector<std::thread> threads;
+            for (size_t c = 0; c < consumers_count; ++c)
+            {
+                threads.emplace_back([&q, &items = consumers_items[c], n = items_count / consumers_count] {
+                    for (size_t i = 0; i < n; ++i)
+                        items.emplace_back(q.pop());
+                });
+            }
+
+            for (size_t p = 0; p < producers_count; ++p)
+            {
+                threads.emplace_back([&q, &items = producers_items[p]] {
+                    for (auto&& item : items)
+                        q.push(std::move(item));
+                });
+            }
+
+            for (auto&& t : threads)
+                t.join();
+
+            state.PauseTiming();
+            producers_items.clear();
+            consumers_items.clear();
+            state.ResumeTiming();
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * items_count));
+    }
+
+    void ping_pong(benchmark::State& state)
+    {
+        // An empty optional stops the echo thread.
+        tc::sdk::blocking_queue<std::optional<T>> ping(1);
+        tc::sdk::blocking_queue<std::optional<T>> pong(1);
+
+        auto echo_thread = std::thread([&ping, &pong] {
+            while (auto item = ping.pop())
+                pong.push(std::move(item));
+        });
+
+        // The same item bounces back and forth, so each iteration measures a full round trip.
+        std::optional<T> item = make_item(0);
+        for (auto _ : state)
+        {
+            ping.push(std::move(item));
+            item = pong.pop();
+            benchmark::DoNotOptimize(item);
+        }
+
+        ping.push(std::nullopt);
+        echo_thread.join();
+    }
+};
+
+}
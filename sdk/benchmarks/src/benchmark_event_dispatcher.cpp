@@ -17,6 +17,7 @@
 #include <chrono>
 #include <iostream>
 #include <thread>
+#include <vector>
 
 namespace tc::sdk::benchmarks
 {
@@ -60,4 +61,116 @@ BENCHMARK_REGISTER_F(benchmark_event_dispatcher, one_event_N_handlers)
     ->ReportAggregatesOnly(false)
     ->DisplayAggregatesOnly(false);
 
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(benchmark_event_dispatcher, emit_queued_handlers)
+(benchmark::State& state)
+{
+    emit_round_trip(state, tc::sdk::event_dispatcher::delivery_mode::queued);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_REGISTER_F(benchmark_event_dispatcher, emit_queued_handlers)
+    ->Arg(1)
+    ->Arg(10)
+    ->ArgName("dispatcher_handlers")
+    ->Unit(benchmark::kNanosecond)
+    ->UseRealTime();
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(benchmark_event_dispatcher, emit_synchronous_handlers)
+(benchmark::State& state)
+{
+    emit_round_trip(state, tc::sdk::event_dispatcher::delivery_mode::synchronous);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_REGISTER_F(benchmark_event_dispatcher, emit_synchronous_handlers)
+    ->Arg(1)
+    ->Arg(10)
+    ->ArgName("dispatcher_handlers")
+    ->Unit(benchmark::kNanosecond)
+    ->UseRealTime();
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(benchmark_event_dispatcher, emit_hybrid_handlers)
+(benchmark::State& state)
+{
+    emit_round_trip(state, tc::sdk::event_dispatcher::delivery_mode::hybrid);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_REGISTER_F(benchmark_event_dispatcher, emit_hybrid_handlers)
+    ->Arg(1)
+    ->Arg(10)
+    ->ArgName("dispatcher_handlers")
+    ->Unit(benchmark::kNanosecond)
+    ->UseRealTime();
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(benchmark_event_dispatcher, emit_large_payload)
+(benchmark::State& state)
+{
+    const auto handlers_count = state.range(0);
+    const auto payload_size = state.range(1);
+    e->start(1);
+
+    std::atomic<int64_t> call_count{0};
+    auto channel = e->channel<std::vector<char>>("Event_1");
+    for (int64_t n = 0; n < handlers_count; ++n)
+        channel.add_handler([&call_count](const std::vector<char>& payload) { call_count.fetch_add(payload.empty() ? 0 : 1, std::memory_order_relaxed); });
+
+    const std::vector<char> payload(payload_size, 'x');
+    int64_t expected_count = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(channel.emit(payload));
+
+        expected_count += handlers_count;
+        while (call_count.load(std::memory_order_relaxed) < expected_count)
+            std::this_thread::yield();
+    }
+
+    state.SetBytesProcessed(state.iterations() * payload_size);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_REGISTER_F(benchmark_event_dispatcher, emit_large_payload)
+    ->ArgsProduct({{1, 10}, {1 << 10, 1 << 20}})
+    ->ArgNames({"dispatcher_handlers", "payload_bytes"})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(benchmark_event_dispatcher, emit_large_payload_by_value)
+(benchmark::State& state)
+{
+    const auto handlers_count = state.range(0);
+    const auto payload_size = state.range(1);
+    e->start(1);
+
+    // Handlers taking the payload by value: all of them but the last one get a copy.
+    std::atomic<int64_t> call_count{0};
+    auto channel = e->channel<std::vector<char>>("Event_1");
+    for (int64_t n = 0; n < handlers_count; ++n)
+        channel.add_handler([&call_count](std::vector<char> payload) { call_count.fetch_add(payload.empty() ? 0 : 1, std::memory_order_relaxed); });
+
+    int64_t expected_count = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(channel.emit(std::vector<char>(payload_size, 'x')));
+
+        expected_count += handlers_count;
+        while (call_count.load(std::memory_order_relaxed) < expected_count)
+            std::this_thread::yield();
+    }
+
+    state.SetBytesProcessed(state.iterations() * payload_size);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_REGISTER_F(benchmark_event_dispatcher, emit_large_payload_by_value)
+    ->ArgsProduct({{1, 10}, {1 << 10, 1 << 20}})
+    ->ArgNames({"dispatcher_handlers", "payload_bytes"})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
 }
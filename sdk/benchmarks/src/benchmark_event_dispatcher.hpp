@@ -16,7 +16,9 @@
 
 #include <teiacare/sdk/event_dispatcher.hpp>
 
+#include <atomic>
 #include <benchmark/benchmark.h>
+#include <thread>
 
 namespace tc::sdk::benchmarks
 {
@@ -37,6 +39,33 @@ public:
 
 protected:
     std::unique_ptr<tc::sdk::event_dispatcher> e;
+
+    /*
+    Emit an event through a channel to state.range(0) cheap handlers (each one increments a counter)
+    and wait for all the handlers to be run: report the round trip time of each emit for the given delivery mode.
+    */
+    void emit_round_trip(benchmark::State& state, tc::sdk::event_dispatcher::delivery_mode delivery)
+    {
+        const auto handlers_count = state.range(0);
+        e->start(1);
+
+        std::atomic<int64_t> call_count{0};
+        auto channel = e->channel<int>("Event_1");
+        for (int64_t n = 0; n < handlers_count; ++n)
+            channel.add_handler([&call_count](int i) { call_count.fetch_add(i, std::memory_order_relaxed); }, {delivery});
+
+        int64_t expected_count = 0;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(channel.emit(1));
+
+            expected_count += handlers_count;
+            while (call_count.load(std::memory_order_relaxed) < expected_count)
+                std::this_thread::yield();
+        }
+
+        state.SetItemsProcessed(expected_count);
+    }
 };
 
 }
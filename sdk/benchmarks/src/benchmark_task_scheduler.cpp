@@ -0,0 +1,191 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "benchmark_task_scheduler.hpp"
+
+namespace tc::sdk::benchmarks
+{
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(benchmark_task_scheduler, recurring_task_allocations_ordered_map)
+(benchmark::State& state)
+{
+    recurring_task_allocations(state, tc::sdk::task_scheduler::timer_backend::ordered_map);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_REGISTER_F(benchmark_task_scheduler, recurring_task_allocations_ordered_map)
+    ->Arg(100)
+    ->Arg(1000)
+    ->ArgName("interval_us")
+    ->Iterations(100)
+    ->UseRealTime();
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(benchmark_task_scheduler, recurring_task_allocations_timing_wheel)
+(benchmark::State& state)
+{
+    recurring_task_allocations(state, tc::sdk::task_scheduler::timer_backend::timing_wheel);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_REGISTER_F(benchmark_task_scheduler, recurring_task_allocations_timing_wheel)
+    ->Arg(100)
+    ->Arg(1000)
+    ->ArgName("interval_us")
+    ->Iterations(100)
+    ->UseRealTime();
+
+// Insert and cancel throughput with 1k to 1M pending tasks.
+static void pending_tasks_args(benchmark::internal::Benchmark* b)
+{
+    b->RangeMultiplier(10)
+        ->Range(1000, 1000000)
+        ->ArgName("pending_tasks")
+        ->Unit(benchmark::kNanosecond)
+        ->UseRealTime();
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(benchmark_task_scheduler, insert_cancel_ordered_map)
+(benchmark::State& state)
+{
+    insert_cancel(state, tc::sdk::task_scheduler::timer_backend::ordered_map, false);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_REGISTER_F(benchmark_task_scheduler, insert_cancel_ordered_map)
+    ->Apply(pending_tasks_args);
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(benchmark_task_scheduler, insert_cancel_timing_wheel)
+(benchmark::State& state)
+{
+    insert_cancel(state, tc::sdk::task_scheduler::timer_backend::timing_wheel, false);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_REGISTER_F(benchmark_task_scheduler, insert_cancel_timing_wheel)
+    ->Apply(pending_tasks_args);
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(benchmark_task_scheduler, insert_cancel_by_id)
+(benchmark::State& state)
+{
+    insert_cancel(state, tc::sdk::task_scheduler::timer_backend::ordered_map, true);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_REGISTER_F(benchmark_task_scheduler, insert_cancel_by_id)
+    ->Apply(pending_tasks_args);
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(benchmark_task_scheduler, lookup_by_id)
+(benchmark::State& state)
+{
+    lookup(state, true);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_REGISTER_F(benchmark_task_scheduler, lookup_by_id)
+    ->Apply(pending_tasks_args);
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(benchmark_task_scheduler, lookup_by_handle)
+(benchmark::State& state)
+{
+    lookup(state, false);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_REGISTER_F(benchmark_task_scheduler, lookup_by_handle)
+    ->Apply(pending_tasks_args);
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(benchmark_task_scheduler, firing_jitter_condition_variable)
+(benchmark::State& state)
+{
+    firing_jitter(state, tc::sdk::task_scheduler::wakeup_backend::condition_variable);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_REGISTER_F(benchmark_task_scheduler, firing_jitter_condition_variable)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->ArgName("frequency_hz")
+    ->Iterations(10)
+    ->UseRealTime();
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(benchmark_task_scheduler, firing_jitter_timerfd)
+(benchmark::State& state)
+{
+    firing_jitter(state, tc::sdk::task_scheduler::wakeup_backend::timerfd);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_REGISTER_F(benchmark_task_scheduler, firing_jitter_timerfd)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->ArgName("frequency_hz")
+    ->Iterations(10)
+    ->UseRealTime();
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(benchmark_task_scheduler, idle_periodic_tasks_ordered_map)
+(benchmark::State& state)
+{
+    idle_periodic_tasks(state, tc::sdk::task_scheduler::timer_backend::ordered_map);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_REGISTER_F(benchmark_task_scheduler, idle_periodic_tasks_ordered_map)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->ArgName("tasks")
+    ->Iterations(10)
+    ->Unit(benchmark::kMillisecond)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime();
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(benchmark_task_scheduler, idle_periodic_tasks_timing_wheel)
+(benchmark::State& state)
+{
+    idle_periodic_tasks(state, tc::sdk::task_scheduler::timer_backend::timing_wheel);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_REGISTER_F(benchmark_task_scheduler, idle_periodic_tasks_timing_wheel)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->ArgName("tasks")
+    ->Iterations(10)
+    ->Unit(benchmark::kMillisecond)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime();
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(benchmark_task_scheduler, on_demand_rearm)
+(benchmark::State& state)
+{
+    on_demand_rearm(state);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_REGISTER_F(benchmark_task_scheduler, on_demand_rearm)
+    ->Unit(benchmark::kNanosecond)
+    ->UseRealTime();
+}
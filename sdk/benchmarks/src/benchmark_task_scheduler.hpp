@@ -0,0 +1,275 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "allocation_counter.hpp"
+
+#include <teiacare/sdk/task_scheduler.hpp>
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <ctime>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tc::sdk::benchmarks
+{
+class benchmark_task_scheduler : public benchmark::Fixture
+{
+public:
+    void SetUp(benchmark::State& st) override
+    {
+    }
+    void TearDown(benchmark::State& st) override
+    {
+    }
+
+protected:
+    static constexpr uint64_t warmup_firings = 100;
+    static constexpr uint64_t firings_per_iteration = 10;
+
+    /*
+    Run a single recurring task at the interval given by state.range(0) (in microseconds)
+    and report the number of heap allocations per firing, measured after a warm up phase.
+    */
+    void recurring_task_allocations(benchmark::State& state, tc::sdk::task_scheduler::timer_backend backend)
+    {
+        const auto interval = std::chrono::microseconds(state.range(0));
+        std::atomic<uint64_t> firings{0};
+
+        tc::sdk::task_scheduler ts(backend, std::chrono::microseconds(10));
+        ts.start(1);
+        ts.every(tc::sdk::task_scheduler::interval_t{interval}, [&firings] { firings.fetch_add(1, std::memory_order_relaxed); });
+
+        // Let the timer structures and the thread pool task queue reach their steady-state capacity.
+        wait_firings(firings, warmup_firings);
+
+        const auto allocations_begin = allocations_count();
+        const auto firings_begin = firings.load();
+
+        for (auto _ : state)
+            wait_firings(firings, firings_per_iteration);
+
+        const auto allocations = allocations_count() - allocations_begin;
+        const auto firings_count = firings.load() - firings_begin;
+        ts.stop();
+
+        state.counters["firings"] = static_cast<double>(firings_count);
+        state.counters["allocations"] = static_cast<double>(allocations);
+        state.counters["allocations_per_firing"] = static_cast<double>(allocations) / static_cast<double>(firings_count);
+    }
+
+    /*
+    Add and cancel one task at a time while state.range(0) other tasks are pending, and report the throughput of the insert + cancel pairs.
+    The tasks are referenced by handle, or by task_id when by_id is set.
+    */
+    void insert_cancel(benchmark::State& state, tc::sdk::task_scheduler::timer_backend backend, bool by_id)
+    {
+        tc::sdk::task_scheduler ts(backend);
+        ts.start(1);
+        add_pending_tasks(ts, static_cast<size_t>(state.range(0)));
+
+        const std::string task_id = "benchmark_task";
+        for (auto _ : state)
+        {
+            if (by_id)
+            {
+                ts.every(std::string(task_id), tc::sdk::task_scheduler::interval_t{pending_interval}, [] {});
+                benchmark::DoNotOptimize(ts.remove_task(task_id));
+            }
+            else
+            {
+                const auto handle = ts.every(tc::sdk::task_scheduler::interval_t{pending_interval}, [] {});
+                benchmark::DoNotOptimize(ts.remove_task(handle));
+            }
+        }
+
+        ts.stop();
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    }
+
+    /*
+    Look up tasks among state.range(0) pending tasks, by task_id or by handle.
+    */
+    void lookup(benchmark::State& state, bool by_id)
+    {
+        const auto tasks_count = static_cast<size_t>(state.range(0));
+
+        tc::sdk::task_scheduler ts;
+        ts.start(1);
+
+        std::vector<std::string> task_ids;
+        std::vector<tc::sdk::task_scheduler::task_handle> handles;
+        task_ids.reserve(tasks_count);
+        handles.reserve(tasks_count);
+        for (size_t n = 0; n < tasks_count; ++n)
+        {
+            task_ids.push_back("task_" + std::to_string(n));
+            handles.push_back(ts.every(std::string(task_ids.back()), tc::sdk::task_scheduler::interval_t{pending_interval}, [] {}));
+        }
+
+        // Visit the tasks with a stride coprime with their count, so that consecutive lookups do not hit neighbouring entries.
+        constexpr size_t stride = 7919;
+        size_t index = 0;
+        for (auto _ : state)
+        {
+            index = (index + stride) % tasks_count;
+            if (by_id)
+                benchmark::DoNotOptimize(ts.is_scheduled(task_ids[index]));
+            else
+                benchmark::DoNotOptimize(ts.is_scheduled(handles[index]));
+        }
+
+        ts.stop();
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    }
+
+    /*
+    Run a single recurring task at the frequency given by state.range(0) (in Hz)
+    and report how late it is started (actual minus scheduled start time), from the task statistics.
+    The percentiles are approximated by the exponential buckets of tc::sdk::task_scheduler::duration_histogram.
+    */
+    void firing_jitter(benchmark::State& state, tc::sdk::task_scheduler::wakeup_backend wakeup)
+    {
+        const auto interval = std::chrono::duration_cast<tc::sdk::clock::duration>(std::chrono::seconds(1)) / state.range(0);
+        std::atomic<uint64_t> firings{0};
+
+        tc::sdk::task_scheduler ts(tc::sdk::task_scheduler::timer_backend::ordered_map, std::chrono::microseconds(1));
+        if (!ts.set_wakeup_backend(wakeup))
+        {
+            state.SkipWithError("Wakeup backend not available");
+            return;
+        }
+
+        ts.set_task_stats_enabled(true);
+        ts.start(1);
+        const auto handle = ts.every(tc::sdk::task_scheduler::interval_t{interval}, [&firings] { firings.fetch_add(1, std::memory_order_relaxed); });
+        wait_firings(firings, warmup_firings);
+
+        const auto stats_begin = ts.get_task_stats(handle);
+        for (auto _ : state)
+            wait_firings(firings, jitter_firings_per_iteration);
+
+        const auto stats_end = ts.get_task_stats(handle);
+        ts.stop();
+
+        if (!stats_begin.has_value() || !stats_end.has_value())
+        {
+            state.SkipWithError("Task statistics not available");
+            return;
+        }
+
+        // Subtract the warm up runs from the histogram, so that only the measured runs are reported.
+        auto lateness = stats_end->lateness;
+        lateness.count -= stats_begin->lateness.count;
+        lateness.total -= stats_begin->lateness.total;
+        for (size_t n = 0; n < lateness.buckets.size(); ++n)
+            lateness.buckets[n] -= stats_begin->lateness.buckets[n];
+
+        state.counters["firings"] = static_cast<double>(lateness.count);
+        state.counters["lateness_mean_us"] = to_microseconds(lateness.mean());
+        state.counters["lateness_p50_us"] = to_microseconds(lateness.percentile(0.5));
+        state.counters["lateness_p99_us"] = to_microseconds(lateness.percentile(0.99));
+        state.counters["lateness_max_us"] = to_microseconds(lateness.max);
+        state.counters["missed_periods"] = static_cast<double>(stats_end->missed_periods - stats_begin->missed_periods);
+    }
+
+    /*
+    Keep state.range(0) recurring tasks doing nothing every 100ms and report the CPU time spent by the whole process
+    (scheduler thread and thread pool) for each second of wall clock time, along with the scheduler thread wakeups.
+    */
+    void idle_periodic_tasks(benchmark::State& state, tc::sdk::task_scheduler::timer_backend backend)
+    {
+        tc::sdk::task_scheduler ts(backend);
+        ts.start(1);
+
+        for (int64_t n = 0; n < state.range(0); ++n)
+            ts.every(tc::sdk::task_scheduler::interval_t{idle_interval}, [] {});
+
+        // Let all the tasks run at least once, so that their phases are settled.
+        std::this_thread::sleep_for(2 * idle_interval);
+        ts.reset_dispatch_stats();
+
+        const auto cpu_begin = std::clock();
+        const auto time_begin = std::chrono::steady_clock::now();
+
+        for (auto _ : state)
+            std::this_thread::sleep_for(idle_interval);
+
+        const auto cpu_seconds = static_cast<double>(std::clock() - cpu_begin) / CLOCKS_PER_SEC;
+        const auto wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - time_begin).count();
+        const auto dispatch_stats = ts.get_dispatch_stats();
+        ts.stop();
+
+        state.counters["cpu_seconds_per_second"] = cpu_seconds / wall_seconds;
+        state.counters["wakeups_per_second"] = static_cast<double>(dispatch_stats.wakeups) / wall_seconds;
+        state.counters["dispatched_per_second"] = static_cast<double>(dispatch_stats.dispatched_tasks) / wall_seconds;
+    }
+
+    /*
+    Re-arm an on demand task over and over (i.e. what tc::sdk::debouncer::trigger does for each event)
+    and report the number of heap allocations per re-arm, which is expected to be zero.
+    */
+    void on_demand_rearm(benchmark::State& state)
+    {
+        tc::sdk::task_scheduler ts;
+        ts.start(1);
+
+        const auto handle = ts.on_demand([] {});
+        const auto delay = std::chrono::hours(1);
+
+        // Let the scheduler thread drain the first requests and reach its steady-state capacity.
+        for (uint64_t n = 0; n < warmup_firings; ++n)
+            ts.reschedule(handle, tc::sdk::clock::now() + delay);
+
+        const auto allocations_begin = allocations_count();
+        for (auto _ : state)
+            benchmark::DoNotOptimize(ts.reschedule(handle, tc::sdk::clock::now() + delay));
+
+        const auto allocations = allocations_count() - allocations_begin;
+        ts.stop();
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+        state.counters["allocations_per_rearm"] = static_cast<double>(allocations) / static_cast<double>(state.iterations());
+    }
+
+private:
+    static constexpr uint64_t jitter_firings_per_iteration = 100;
+    static constexpr auto pending_interval = std::chrono::hours(1);
+    static constexpr auto idle_interval = std::chrono::milliseconds(100);
+
+    // Pending tasks far in the future, that never fire during the benchmark.
+    static void add_pending_tasks(tc::sdk::task_scheduler& ts, size_t count)
+    {
+        for (size_t n = 0; n < count; ++n)
+            ts.every(tc::sdk::task_scheduler::interval_t{pending_interval}, [] {});
+    }
+
+    static double to_microseconds(tc::sdk::clock::duration d)
+    {
+        return std::chrono::duration<double, std::micro>(d).count();
+    }
+
+    static void wait_firings(const std::atomic<uint64_t>& firings, uint64_t count)
+    {
+        const auto target = firings.load() + count;
+        while (firings.load() < target)
+            std::this_thread::yield();
+    }
+};
+
+}
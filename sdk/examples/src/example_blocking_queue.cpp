@@ -112,5 +112,34 @@ int main()
         spdlog::info("finished!");
     }
 
+    {
+        auto commands = tc::sdk::blocking_queue<int>(4);
+        auto control = tc::sdk::blocking_queue<std::string>(4);
+
+        auto producer_thread = std::thread([&] {
+            commands.push(1);
+            commands.push(2);
+            control.push("stop");
+        });
+
+        bool is_running = true;
+        while (is_running)
+        {
+            // Block until either commands or control holds an item
+            switch (tc::sdk::wait_any(commands, control))
+            {
+            case 0:
+                spdlog::debug("command: {}", commands.pop());
+                break;
+            case 1:
+                spdlog::warn("control: {}", control.pop());
+                is_running = false;
+                break;
+            }
+        }
+
+        producer_thread.join();
+    }
+
     return 0;
 }
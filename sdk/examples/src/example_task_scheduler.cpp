@@ -90,11 +90,11 @@ int main()
 
     // Every
     {
-        bool is_scheduled = s.every("task_id", 100ms, [] {
+        auto handle = s.every("task_id", 100ms, [] {
             spdlog::info("Every 100ms");
             std::this_thread::sleep_for(50ms);
         });
-        spdlog::info("Scheduled task recursively: {}", is_scheduled);
+        spdlog::info("Scheduled task recursively: {}", handle.is_valid());
         std::this_thread::sleep_for(1s);
 
         s.update_interval("task_id", 400ms);
@@ -104,6 +104,37 @@ int main()
         std::this_thread::sleep_for(1s);
     }
 
+    // Handle
+    {
+        // Tasks scheduled without a task_id can be managed through their task_handle.
+        auto handle = s.every(100ms, [] { spdlog::info("Anonymous every 100ms"); });
+        std::this_thread::sleep_for(500ms);
+
+        s.update_interval(handle, 200ms);
+        std::this_thread::sleep_for(1s);
+
+        s.remove_task(handle);
+    }
+
+    // Overlap policy
+    {
+        // The task is slower than its interval: overlapping runs are skipped instead of piling up in the thread pool.
+        auto handle = s.every("slow_task", 100ms, tc::sdk::task_scheduler::delay_t{100ms}, [] { std::this_thread::sleep_for(250ms); });
+        s.set_overlap_policy(handle, tc::sdk::task_scheduler::overlap_policy::skip);
+        std::this_thread::sleep_for(1s);
+
+        spdlog::info("Skipped runs: {}", s.get_overlap_stats(handle)->skipped_runs);
+        s.remove_task(handle);
+    }
+
+    // Calendar schedule
+    {
+        // Every 2 seconds of the UTC system time, following a cron expression (seconds minutes hours day-of-month month day-of-week).
+        auto handle = s.every(tc::sdk::cron_schedule::from_string("*/2 * * * * *"), [] { spdlog::info("Calendar task"); });
+        std::this_thread::sleep_for(5s);
+        s.remove_task(handle);
+    }
+
     // Nested
     {
         s.in(1s, [&s] {
@@ -16,15 +16,52 @@
 
 #include <teiacare/sdk/non_copyable.hpp>
 #include <teiacare/sdk/non_moveable.hpp>
+#include <teiacare/sdk/queue_stats.hpp>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <mutex>
 #include <optional>
 #include <queue>
 
 namespace tc::sdk
 {
+/**
+ * @cond SKIP_DOXYGEN
+ */
+namespace detail
+{
+struct select_waiter
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool is_signaled = false;
+
+    void signal()
+    {
+        {
+            std::scoped_lock lock(mutex);
+            is_signaled = true;
+        }
+        cv.notify_one();
+    }
+};
+
+struct select_link
+{
+    select_waiter* waiter = nullptr;
+    select_link* prev = nullptr;
+    select_link* next = nullptr;
+};
+
+struct queue_selector;
+}
+/** @endcond */
+
 /*!
  * \class blocking_queue
  * \brief Thread safe, blocking queue
@@ -33,6 +70,7 @@ namespace tc::sdk
  * The queue has a fixed capacity (i.e. maximum number of items that can be hold).
  * When the queue is full and a new item is needs to be inserted via blocking_queue::push() the queue blocks until an item is popped.
  * Viceversa, when the queue is empty and an item is required via blocking_queue::pop(), the queue blocks until the first item is pushed.
+ * Each push (pop) wakes up at most a single blocked consumer (producer), and no notification is issued at all when nobody is waiting.
  */
 template <typename T>
 class blocking_queue : private non_copyable, private non_moveable
@@ -66,7 +104,11 @@ public:
     {
         std::unique_lock lock(_mutex);
         if (is_full())
-            _last_item_popped.wait(lock, [this] { return !is_full(); });
+        {
+            const auto wait_begin = _stats.wait_begin();
+            wait_not_full(lock);
+            _stats.on_push_blocked(wait_begin);
+        }
 
         _queue.push(item);
         push_impl(std::move(lock));
@@ -83,9 +125,13 @@ public:
     {
         std::unique_lock lock(_mutex);
         if (is_full())
-            _last_item_popped.wait(lock, [this] { return !is_full(); });
+        {
+            const auto wait_begin = _stats.wait_begin();
+            wait_not_full(lock);
+            _stats.on_push_blocked(wait_begin);
+        }
 
-        _queue.emplace(item);
+        _queue.emplace(std::move(item));
         push_impl(std::move(lock));
     }
 
@@ -124,7 +170,7 @@ public:
         if (is_full())
             return false;
 
-        _queue.emplace(item);
+        _queue.emplace(std::move(item));
         push_impl(std::move(lock));
 
         return true;
@@ -140,9 +186,13 @@ public:
     {
         std::unique_lock lock(_mutex);
         if (is_empty())
-            _first_item_pushed.wait(lock, [this] { return !is_empty(); });
+        {
+            const auto wait_begin = _stats.wait_begin();
+            wait_not_empty(lock);
+            _stats.on_pop_blocked(wait_begin);
+        }
 
-        T item = _queue.front();
+        T item = std::move(_queue.front());
         _queue.pop();
         pop_impl(std::move(lock));
 
@@ -162,11 +212,11 @@ public:
         if (is_empty())
             return std::nullopt;
 
-        T item = _queue.front();
+        std::optional<T> item = std::move(_queue.front());
         _queue.pop();
         pop_impl(std::move(lock));
 
-        return std::move(std::optional(item));
+        return item;
     }
 
     /*!
@@ -189,29 +239,98 @@ public:
         return _capacity;
     }
 
+    /*!
+     * \brief Get a snapshot of the queue counters
+     * \return tc::sdk::queue_stats snapshot
+     *
+     * The snapshot reports current and peak size, total pushes and pops and the time spent by producers and consumers blocked on the queue.
+     * Counters are only available when the project is configured with TC_ENABLE_QUEUE_STATS (see tc::sdk::queue_stats_enabled),
+     * otherwise they compile out and a zero initialized snapshot is returned.
+     */
+    [[nodiscard]] queue_stats stats() const
+    {
+        std::lock_guard lock(_mutex);
+        return _stats.snapshot(_queue.size());
+    }
+
 private:
+    friend struct detail::queue_selector;
+
     std::queue<T> _queue;
     mutable std::mutex _mutex;
-    std::condition_variable _last_item_popped;
-    std::condition_variable _first_item_pushed;
     const size_t _capacity;
+    detail::select_link* _select_links = nullptr;
+    detail::queue_stats_recorder _stats;
+
+    // Futex words: blocked consumers wait on _push_epoch, blocked producers wait on _pop_epoch.
+    // Each push (pop) bumps the epoch and wakes a single waiter, only if at least one consumer (producer) is waiting,
+    // so that exactly one waiter is woken up for each item and no notification is issued when nobody is waiting.
+    // The waiters counters are protected by _mutex.
+    std::atomic<uint32_t> _push_epoch{0};
+    std::atomic<uint32_t> _pop_epoch{0};
+    size_t _waiting_consumers = 0;
+    size_t _waiting_producers = 0;
 
     inline void push_impl(std::unique_lock<std::mutex>&& lock)
     {
-        const bool is_first_item_pushed = _queue.size() == 1;
+        _stats.on_push(_queue.size());
+
+        // Selectors must be signaled while the queue lock is held,
+        // since a selector can only detach itself (and go out of scope) after acquiring it.
+        if (_queue.size() == 1)
+        {
+            for (auto link = _select_links; link != nullptr; link = link->next)
+                link->waiter->signal();
+        }
+
+        const bool is_consumer_waiting = _waiting_consumers > 0;
+        if (is_consumer_waiting)
+            _push_epoch.fetch_add(1, std::memory_order_release);
+
         lock.unlock();
 
-        if (is_first_item_pushed)
-            _first_item_pushed.notify_all();
+        if (is_consumer_waiting)
+            _push_epoch.notify_one();
     }
 
     inline void pop_impl(std::unique_lock<std::mutex>&& lock)
     {
-        const bool is_last_item_popped = _queue.size() == _capacity - 1;
+        _stats.on_pop();
+
+        const bool is_producer_waiting = _waiting_producers > 0;
+        if (is_producer_waiting)
+            _pop_epoch.fetch_add(1, std::memory_order_release);
+
         lock.unlock();
 
-        if (is_last_item_popped)
-            _last_item_popped.notify_all();
+        if (is_producer_waiting)
+            _pop_epoch.notify_one();
+    }
+
+    inline void wait_not_empty(std::unique_lock<std::mutex>& lock)
+    {
+        wait_epoch(lock, _push_epoch, _waiting_consumers, [this] { return !is_empty(); });
+    }
+
+    inline void wait_not_full(std::unique_lock<std::mutex>& lock)
+    {
+        wait_epoch(lock, _pop_epoch, _waiting_producers, [this] { return !is_full(); });
+    }
+
+    template <typename Predicate>
+    static void wait_epoch(std::unique_lock<std::mutex>& lock, std::atomic<uint32_t>& epoch, size_t& waiters, Predicate&& is_ready)
+    {
+        ++waiters;
+        while (!is_ready())
+        {
+            // The epoch is sampled with the lock held: any push (pop) happening after the lock is released
+            // bumps the epoch, so that the wait below returns immediately and no wakeup can be lost.
+            const uint32_t current_epoch = epoch.load(std::memory_order_relaxed);
+            lock.unlock();
+            epoch.wait(current_epoch, std::memory_order_acquire);
+            lock.lock();
+        }
+        --waiters;
     }
 
     inline bool is_empty() const
@@ -222,6 +341,135 @@ private:
     {
         return _queue.size() >= _capacity;
     }
+
+    bool attach(detail::select_link& link)
+    {
+        std::scoped_lock lock(_mutex);
+        link.prev = nullptr;
+        link.next = _select_links;
+        if (_select_links != nullptr)
+            _select_links->prev = &link;
+
+        _select_links = &link;
+        return !is_empty();
+    }
+
+    bool detach(detail::select_link& link)
+    {
+        std::scoped_lock lock(_mutex);
+        if (link.prev != nullptr)
+            link.prev->next = link.next;
+        else
+            _select_links = link.next;
+
+        if (link.next != nullptr)
+            link.next->prev = link.prev;
+
+        return !is_empty();
+    }
 };
 
+/**
+ * @cond SKIP_DOXYGEN
+ */
+namespace detail
+{
+struct queue_selector
+{
+    template <typename WaitFunction, typename... Ts>
+    static std::optional<size_t> select(WaitFunction&& wait, blocking_queue<Ts>&... queues)
+    {
+        static_assert(sizeof...(Ts) > 0, "\nat least one blocking_queue is required!");
+
+        select_waiter waiter;
+        std::array<select_link, sizeof...(Ts)> links;
+        for (auto&& link : links)
+            link.waiter = &waiter;
+
+        while (true)
+        {
+            std::array<bool, sizeof...(Ts)> is_ready{};
+
+            size_t index = 0;
+            ((is_ready[index] = queues.attach(links[index]), ++index), ...);
+
+            bool is_timeout = false;
+            if (std::none_of(is_ready.begin(), is_ready.end(), [](bool r) { return r; }))
+                is_timeout = !wait(waiter);
+
+            index = 0;
+            ((is_ready[index] = queues.detach(links[index]) || is_ready[index], ++index), ...);
+
+            if (auto ready = std::find(is_ready.begin(), is_ready.end(), true); ready != is_ready.end())
+                return static_cast<size_t>(std::distance(is_ready.begin(), ready));
+
+            if (is_timeout)
+                return std::nullopt;
+
+            // Signaled but the item has already been consumed by another thread: wait again.
+            std::scoped_lock lock(waiter.mutex);
+            waiter.is_signaled = false;
+        }
+    }
+};
+}
+/** @endcond */
+
+/*!
+ * \brief Wait until any of the given queues holds at least one item
+ * \tparam Ts Items types of the given queues
+ * \param queues Queues to wait on
+ * \return Index (in the parameters list) of the first queue found not empty
+ *
+ * The calling thread is blocked (without polling) until an item is pushed into any of the given queues.
+ * Note that the returned index only reports the queue readiness: if other consumers are popping from the same queue
+ * the item might be already gone when the caller tries to retrieve it, hence blocking_queue::try_pop() should be preferred.
+ */
+template <typename... Ts>
+size_t wait_any(blocking_queue<Ts>&... queues)
+{
+    auto wait = [](detail::select_waiter& w) {
+        std::unique_lock lock(w.mutex);
+        w.cv.wait(lock, [&w] { return w.is_signaled; });
+        return true;
+    };
+
+    return detail::queue_selector::select(wait, queues...).value();
+}
+
+/*!
+ * \brief Wait until any of the given queues holds at least one item or the given time_point is reached
+ * \tparam Ts Items types of the given queues
+ * \param deadline Maximum time_point to wait until
+ * \param queues Queues to wait on
+ * \return Index (in the parameters list) of the first queue found not empty, std::nullopt if the deadline is reached
+ *
+ * Same as tc::sdk::wait_any(), with a timeout expressed as an absolute time_point.
+ */
+template <typename Clock, typename Duration, typename... Ts>
+std::optional<size_t> wait_any_until(const std::chrono::time_point<Clock, Duration>& deadline, blocking_queue<Ts>&... queues)
+{
+    auto wait = [&deadline](detail::select_waiter& w) {
+        std::unique_lock lock(w.mutex);
+        return w.cv.wait_until(lock, deadline, [&w] { return w.is_signaled; });
+    };
+
+    return detail::queue_selector::select(wait, queues...);
+}
+
+/*!
+ * \brief Wait until any of the given queues holds at least one item or the given timeout expires
+ * \tparam Ts Items types of the given queues
+ * \param timeout Maximum duration to wait for
+ * \param queues Queues to wait on
+ * \return Index (in the parameters list) of the first queue found not empty, std::nullopt if the timeout expires
+ *
+ * Same as tc::sdk::wait_any(), with a timeout expressed as a relative duration.
+ */
+template <typename Rep, typename Period, typename... Ts>
+std::optional<size_t> wait_any_for(const std::chrono::duration<Rep, Period>& timeout, blocking_queue<Ts>&... queues)
+{
+    return wait_any_until(std::chrono::steady_clock::now() + timeout, queues...);
+}
+
 }
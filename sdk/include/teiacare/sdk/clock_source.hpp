@@ -0,0 +1,182 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <teiacare/sdk/clock.hpp>
+#include <teiacare/sdk/non_copyable.hpp>
+#include <teiacare/sdk/non_moveable.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace tc::sdk
+{
+/*!
+ * \class clock_source
+ * \brief Source of time used by tc::sdk::task_scheduler, tc::sdk::high_precision_timer and tc::sdk::rate_limiter.
+ *
+ * All the time based components read the current time and wait for their deadlines through a clock_source,
+ * so that the real tc::sdk::clock (see tc::sdk::clock_source::steady) can be replaced by a tc::sdk::manual_clock in tests and simulations.
+ * The waiting functions may return spuriously: callers must check their deadline again.
+ */
+class clock_source : private non_copyable, private non_moveable
+{
+public:
+    virtual ~clock_source() = default;
+
+    /*!
+     * \brief Get the current time.
+     */
+    virtual tc::sdk::clock::time_point now() const = 0;
+
+    /*!
+     * \brief Get the current system (wall clock) time, used by the calendar based schedules.
+     */
+    virtual tc::sdk::sys_time_point system_now() const = 0;
+
+    /*!
+     * \brief Wait on a condition variable until it is notified or the given time_point is reached.
+     * \param cv condition variable to wait on, previously registered with tc::sdk::clock_source::subscribe.
+     * \param lock lock owning the mutex registered along with the condition variable.
+     * \param timepoint deadline of the wait.
+     */
+    virtual void wait_until(std::condition_variable& cv, std::unique_lock<std::mutex>& lock, tc::sdk::clock::time_point timepoint) = 0;
+
+    /*!
+     * \brief Wait on a condition variable until it is notified.
+     * \param cv condition variable to wait on, previously registered with tc::sdk::clock_source::subscribe.
+     * \param lock lock owning the mutex registered along with the condition variable.
+     */
+    virtual void wait(std::condition_variable& cv, std::unique_lock<std::mutex>& lock) = 0;
+
+    /*!
+     * \brief Block the calling thread until the given time_point is reached.
+     */
+    virtual void sleep_until(tc::sdk::clock::time_point timepoint) = 0;
+
+    /*!
+     * \brief Register a condition variable (along with its mutex) that waits on this clock.
+     *
+     * Clocks that can be moved forward (e.g. tc::sdk::manual_clock) notify all the registered condition variables every time they change their time.
+     * The condition variable must be unregistered before it is destroyed.
+     */
+    virtual void subscribe(std::condition_variable& cv, std::mutex& mtx);
+
+    /*!
+     * \brief Unregister a condition variable registered with tc::sdk::clock_source::subscribe.
+     */
+    virtual void unsubscribe(std::condition_variable& cv);
+
+    /*!
+     * \brief Get the clock_source reading the real tc::sdk::clock.
+     * \return Shared instance of the steady clock_source, used by default by all the time based components.
+     */
+    static std::shared_ptr<clock_source> steady();
+
+protected:
+    clock_source() = default;
+};
+
+/*!
+ * \class steady_clock_source
+ * \brief clock_source reading tc::sdk::clock (std::chrono::steady_clock) and std::chrono::system_clock.
+ */
+class steady_clock_source final : public clock_source
+{
+public:
+    tc::sdk::clock::time_point now() const override;
+    tc::sdk::sys_time_point system_now() const override;
+    void wait_until(std::condition_variable& cv, std::unique_lock<std::mutex>& lock, tc::sdk::clock::time_point timepoint) override;
+    void wait(std::condition_variable& cv, std::unique_lock<std::mutex>& lock) override;
+    void sleep_until(tc::sdk::clock::time_point timepoint) override;
+};
+
+/*!
+ * \class manual_clock
+ * \brief Virtual clock_source whose time only changes when it is explicitly moved forward.
+ *
+ * Hours of scheduled activity can be simulated in a fraction of a second by moving the clock forward
+ * with tc::sdk::manual_clock::advance: all the waiting components are woken up immediately.
+ * Components run on their own threads, so tc::sdk::manual_clock::wait_for_idle can be used to wait until they
+ * have handled the new time (i.e. until they are blocked again waiting on the clock) before moving it forward again.
+ * The clock must not be moved forward from the callbacks run by the components while they hold their own locks (e.g. tc::sdk::high_precision_timer callbacks).
+ */
+class manual_clock final : public clock_source
+{
+public:
+    /*!
+     * \brief Constructor
+     * \param start initial time of the clock.
+     * \param system_start system time corresponding to the initial time of the clock.
+     */
+    explicit manual_clock(tc::sdk::clock::time_point start = tc::sdk::clock::time_point{}, tc::sdk::sys_time_point system_start = tc::sdk::sys_time_point{});
+
+    tc::sdk::clock::time_point now() const override;
+    tc::sdk::sys_time_point system_now() const override;
+    void wait_until(std::condition_variable& cv, std::unique_lock<std::mutex>& lock, tc::sdk::clock::time_point timepoint) override;
+    void wait(std::condition_variable& cv, std::unique_lock<std::mutex>& lock) override;
+    void sleep_until(tc::sdk::clock::time_point timepoint) override;
+    void subscribe(std::condition_variable& cv, std::mutex& mtx) override;
+    void unsubscribe(std::condition_variable& cv) override;
+
+    /*!
+     * \brief Move the clock forward.
+     * \param duration time to add to the clock (negative durations are ignored).
+     *
+     * All the threads waiting on the clock are woken up.
+     */
+    void advance(tc::sdk::clock::duration duration);
+
+    /*!
+     * \brief Move the clock forward to the given time_point.
+     * \param timepoint new time of the clock: the clock never goes backward, so earlier time_points are ignored.
+     */
+    void advance_to(tc::sdk::clock::time_point timepoint);
+
+    /*!
+     * \brief Wait until the given number of threads are blocked waiting on the clock since it has been moved forward for the last time.
+     * \param threads_count number of threads to wait for (e.g. one for each tc::sdk::task_scheduler or tc::sdk::high_precision_timer using the clock).
+     *
+     * A component blocked on the clock after the last change of time has handled all its deadlines up to the current time.
+     */
+    void wait_for_idle(size_t threads_count = 1);
+
+private:
+    void block_on(std::condition_variable& cv, std::unique_lock<std::mutex>& lock, std::optional<tc::sdk::clock::time_point> timepoint);
+    void notify_subscribers();
+
+    const tc::sdk::clock::time_point _start;
+    const tc::sdk::sys_time_point _system_start;
+    std::atomic<tc::sdk::clock::rep> _now;
+
+    // Guards the time updates and the count of the blocked threads. It is never held while acquiring another lock.
+    std::mutex _state_mtx;
+    std::condition_variable _state_cv;
+    size_t _blocked_threads_count;
+    uint64_t _epoch; // Incremented every time the clock is moved forward.
+
+    std::mutex _subscribers_mtx;
+    std::vector<std::pair<std::condition_variable*, std::mutex*>> _subscribers;
+
+    std::mutex _sleep_mtx;
+    std::condition_variable _sleep_cv;
+};
+
+}
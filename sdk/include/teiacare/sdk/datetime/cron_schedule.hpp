@@ -0,0 +1,123 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <teiacare/sdk/datetime/datetime.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+
+namespace tc::sdk
+{
+/*!
+ * \class cron_schedule
+ * \brief Calendar based schedule described by a cron expression, evaluated against tc::sdk::datetime (UTC).
+ *
+ * The expression is made of 5 fields (minute, hour, day of month, month, day of week)
+ * or 6 fields, with an additional leading seconds field. Each field supports:
+ * - \c * (or \c ?): any value.
+ * - single values, ranges (\c 1-5) and lists (\c 1,15,30).
+ * - steps on ranges and wildcards (\c 0-30/10, \c *\/15), or starting from a value up to the field maximum (\c 5/15).
+ * - month names (\c JAN - \c DEC) and day of week names (\c SUN - \c SAT), case insensitive. Both 0 and 7 are Sunday.
+ *
+ * The \c \@yearly (\c \@annually), \c \@monthly, \c \@weekly, \c \@daily (\c \@midnight) and \c \@hourly macros are supported too.
+ * As in the standard cron implementations, when both the day of month and the day of week fields are restricted (i.e. not a wildcard)
+ * a day matches if it matches either of them.
+ */
+class cron_schedule
+{
+public:
+    /*!
+     * \brief Copy Constructor. Copy a tc::sdk::cron_schedule instance to another one.
+     */
+    cron_schedule(const cron_schedule&) = default;
+
+    /*!
+     * \brief Move Constructor. Move a tc::sdk::cron_schedule instance to another one.
+     */
+    cron_schedule(cron_schedule&&) noexcept = default;
+
+    /*!
+     * \brief Copy assignment operator. Copy a tc::sdk::cron_schedule instance to another one.
+     */
+    cron_schedule& operator=(const cron_schedule&) = default;
+
+    /*!
+     * \brief Move assignment operator. Move a tc::sdk::cron_schedule instance to another one.
+     */
+    cron_schedule& operator=(cron_schedule&&) noexcept = default;
+
+    /*!
+     * \brief Creates a cron_schedule object from a cron expression.
+     * \param expression The cron expression.
+     * \return A cron_schedule object representing the parsed expression.
+     * \throws std::runtime_error if the expression is not valid.
+     */
+    static tc::sdk::cron_schedule from_string(const std::string& expression) noexcept(false);
+
+    /*!
+     * \brief Computes the first datetime matching the schedule strictly after the given datetime.
+     * \param after The datetime to start from.
+     * \return The next matching datetime (with a whole number of seconds), or std::nullopt if the schedule never matches again (e.g. 30th of February).
+     *
+     * The computation is incremental: each field skips directly to its next allowed value,
+     * restarting the lower fields from their minimum allowed value, so that the cost does not depend on the distance between the two datetimes.
+     */
+    std::optional<tc::sdk::datetime> next(const tc::sdk::datetime& after) const;
+
+    /*!
+     * \brief Check if a datetime matches the schedule.
+     * \param dt The datetime to check (the fractional part of its seconds is ignored).
+     * \return true if the datetime matches all the fields of the schedule.
+     */
+    bool matches(const tc::sdk::datetime& dt) const;
+
+    /*!
+     * \brief Get the cron expression of the schedule.
+     * \return The cron expression the schedule has been created from.
+     */
+    const std::string& to_string() const noexcept
+    {
+        return _expression;
+    }
+
+    /*!
+     * \brief Output stream operator.
+     * \param stream the output stream to write into.
+     * \param schedule the cron_schedule object to stream.
+     * \return reference to the output stream operator, with the cron expression written into it.
+     */
+    friend std::ostream& operator<<(std::ostream& stream, const cron_schedule& schedule);
+
+private:
+    cron_schedule() = default;
+
+    std::optional<unsigned> next_day(const std::chrono::year& y, const std::chrono::month& m, unsigned from) const;
+    bool matches_day(unsigned day, unsigned weekday) const;
+
+    // Bitmasks of the allowed values of each field: bit N is set if value N is allowed.
+    uint64_t _seconds = 0;
+    uint64_t _minutes = 0;
+    uint32_t _hours = 0;
+    uint32_t _days_of_month = 0; // Bits 1 to 31.
+    uint16_t _months = 0;        // Bits 1 to 12.
+    uint8_t _days_of_week = 0;   // Bits 0 (Sunday) to 6 (Saturday).
+    bool _is_day_of_month_restricted = false;
+    bool _is_day_of_week_restricted = false;
+    std::string _expression;
+};
+
+}
@@ -0,0 +1,91 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <teiacare/sdk/clock.hpp>
+#include <teiacare/sdk/non_copyable.hpp>
+#include <teiacare/sdk/non_moveable.hpp>
+#include <teiacare/sdk/task_scheduler.hpp>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace tc::sdk
+{
+/*!
+ * \class debouncer
+ * \brief Run a callback once a burst of events is over.
+ *
+ * Each call to tc::sdk::debouncer::trigger restarts the delay: the callback runs on the tc::sdk::task_scheduler thread pool
+ * only when no event has been triggered for the whole delay, so a burst of events results in a single call.
+ * The debouncer is backed by a single tc::sdk::task_scheduler::on_demand task: re-arming it is O(1) and never allocates.
+ */
+class debouncer : private non_copyable, private non_moveable
+{
+public:
+    /*!
+     * \brief Constructor
+     * \param scheduler Running tc::sdk::task_scheduler used to run the callback
+     * \param delay Quiet time after the last event before the callback is run
+     * \param callback Callback function
+     *
+     * Creates a tc::sdk::debouncer instance. The scheduler must be running and it must outlive the debouncer.
+     */
+    debouncer(tc::sdk::task_scheduler& scheduler, tc::sdk::clock::duration delay, std::function<void()> callback);
+
+    /*!
+     * \brief Destructor
+     *
+     * Cancels the pending call, if any, and waits for the running callback to complete.
+     * The destructor must not be called from the callback itself.
+     */
+    ~debouncer();
+
+    /*!
+     * \brief Notify a new event, restarting the delay
+     * \return true if the callback has been armed, false if the debouncer is not bound to a running scheduler
+     */
+    bool trigger();
+
+    /*!
+     * \brief Cancel the pending call, if any
+     * \return true if a call was pending
+     */
+    bool cancel();
+
+    /*!
+     * \brief Check if a call is pending
+     * \return true if the callback will be run once the delay is over
+     */
+    bool is_pending() const;
+
+private:
+    // Shared with the scheduler task, which can outlive the debouncer while it is queued in the thread pool.
+    struct state
+    {
+        std::function<void()> callback;
+        std::atomic<bool> is_pending{false};
+        std::atomic<bool> is_cancelled{false};
+        std::atomic<size_t> running_count{0};
+    };
+
+    tc::sdk::task_scheduler& _scheduler;
+    const tc::sdk::clock::duration _delay;
+    std::shared_ptr<state> _state;
+    tc::sdk::task_scheduler::task_handle _handle;
+};
+
+}
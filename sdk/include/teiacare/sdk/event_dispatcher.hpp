@@ -14,16 +14,26 @@
 
 #pragma once
 
+#include <teiacare/sdk/clock.hpp>
 #include <teiacare/sdk/function_traits.hpp>
 #include <teiacare/sdk/non_copyable.hpp>
 #include <teiacare/sdk/non_moveable.hpp>
 #include <teiacare/sdk/thread_pool.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <tuple>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace tc::sdk
@@ -37,11 +47,34 @@ namespace tc::sdk
  */
 class event_dispatcher final : private non_copyable, private non_moveable
 {
+public:
+    /*!
+     * \brief Delivery mode of an event handler.
+     */
+    enum class delivery_mode
+    {
+        queued,      //!< The handler is run on the thread pool (default).
+        synchronous, //!< The handler is run inline by emit(), on the emitting thread: no task is queued and no thread hop takes place.
+        hybrid       //!< The handler is run inline while its estimated cost is within the hybrid threshold, on the thread pool otherwise.
+    };
+
+    /*!
+     * \struct handler_options
+     * \brief Options of an event handler, see tc::sdk::event_dispatcher::add_handler.
+     */
+    struct handler_options
+    {
+        delivery_mode delivery = delivery_mode::queued; //!< How the handler is run when the event is emitted.
+        tc::sdk::clock::duration cost_hint{0};          //!< Initial estimate of the handler execution time, refined by each run of delivery_mode::hybrid handlers.
+    };
+
 private:
     struct base_handler_t
     {
-        explicit base_handler_t(unsigned long id) noexcept
+        base_handler_t(unsigned long id, handler_options options) noexcept
             : id{id}
+            , delivery{options.delivery}
+            , cost{options.cost_hint.count()}
         {
         }
         virtual ~base_handler_t() noexcept
@@ -53,29 +86,412 @@ private:
         base_handler_t& operator=(base_handler_t&&) = delete;
 
         const unsigned long id;
+        const delivery_mode delivery;
+        mutable std::atomic<tc::sdk::clock::rep> cost; // Estimated execution time (exponential moving average), only updated for the hybrid handlers.
     };
 
+    // Handlers get the event payload by const reference: the same payload is shared by all the handlers of an emit.
+    // Consumers, the handlers that take ownership of their arguments (by value or by non const reference), get a payload of their own instead:
+    // a copy of the shared payload, or the shared payload itself when they are its last reader, moved into their arguments.
     template <typename... Args>
     class handler_t : public base_handler_t, private non_copyable, private non_moveable
     {
     public:
-        handler_t(unsigned long id, std::function<void(Args...)>&& h) noexcept
-            : base_handler_t(id)
-            , _handler{std::move(h)}
+        using reader_t = std::function<void(const Args&...)>;
+        using consumer_t = std::function<void(std::tuple<Args...>&&)>;
+
+        handler_t(unsigned long id, handler_options options, reader_t&& h) noexcept
+            : base_handler_t(id, options)
+            , _reader{std::move(h)}
+        {
+        }
+        handler_t(unsigned long id, handler_options options, consumer_t&& h) noexcept
+            : base_handler_t(id, options)
+            , _consumer{std::move(h)}
         {
         }
         ~handler_t() noexcept override = default;
 
-        void call(Args... args) const
+        bool is_consumer() const noexcept
         {
-            _handler(std::forward<Args>(args)...);
+            return static_cast<bool>(_consumer);
+        }
+
+        // Read the shared payload: consumers get a copy of it.
+        void call(const std::tuple<Args...>& payload) const
+        {
+            if (_consumer)
+                _consumer(std::tuple<Args...>(payload));
+            else
+                std::apply(_reader, payload);
+        }
+
+        // Take the payload, no other handler reads it anymore.
+        void call(std::tuple<Args...>&& payload) const
+        {
+            if (_consumer)
+                _consumer(std::move(payload));
+            else
+                std::apply(_reader, payload);
         }
 
     private:
-        std::function<void(Args...)> _handler;
+        reader_t _reader;
+        consumer_t _consumer;
+    };
+
+    // Handler arguments that can be bound to the shared (immutable) payload: const references, and values that are as cheap to copy as to move.
+    template <typename T>
+    static constexpr bool is_shared_payload_argument_v = (std::is_lvalue_reference_v<T> && std::is_const_v<std::remove_reference_t<T>>)
+        || (!std::is_reference_v<T> && std::is_trivially_copyable_v<T>);
+
+    // Adapts a user defined handler to the payload of the emits, according to the types of its arguments.
+    template <typename HandlerArgsT>
+    struct handler_adapter_t;
+
+    template <typename... HandlerArgs>
+    struct handler_adapter_t<std::tuple<HandlerArgs...>>
+    {
+        static constexpr bool is_reader = (is_shared_payload_argument_v<HandlerArgs> && ...);
+
+        // The arguments taken by value (or by rvalue reference) are moved from the payload owned by the call.
+        template <typename T>
+        using consumed_argument_t = std::conditional_t<std::is_lvalue_reference_v<T>, T, std::decay_t<T>&&>;
+
+        template <typename HandlerT>
+        static auto consumer(HandlerT&& event_handler)
+        {
+            return [h = std::forward<HandlerT>(event_handler)](std::tuple<std::decay_t<HandlerArgs>...>&& payload) mutable {
+                std::apply([&h](std::decay_t<HandlerArgs>&... args) { h(static_cast<consumed_argument_t<HandlerArgs>>(args)...); }, payload);
+            };
+        }
+    };
+
+    // Unique type for each ordered list of event arguments: its std::type_index identifies the event signature.
+    template <typename... Args>
+    struct signature_t
+    {
     };
 
+    // An event is identified by its name and by the exact (ordered) list of its argument types.
+    struct event_key_t
+    {
+        std::string name;
+        std::type_index signature;
+
+        bool operator==(const event_key_t&) const = default;
+    };
+
+    struct event_key_hash_t
+    {
+        size_t operator()(const event_key_t& key) const noexcept
+        {
+            const auto h = std::hash<std::string>{}(key.name);
+            return h ^ (key.signature.hash_code() + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+        }
+    };
+
+    using handlers_list_t = std::vector<std::shared_ptr<base_handler_t>>;
+
+    // Epoch based reclamation of the snapshots, shared by all the event_dispatcher instances.
+    // Each thread owns a reader slot, on its own cache line, where it stores the global epoch while it reads snapshots:
+    // entering and leaving a read-side section only reads the global epoch and writes the slot of the calling thread,
+    // so the emits of different threads never write the same cache line.
+    // A snapshot retired at epoch E can be destroyed once no reader slot holds an epoch up to E: the readers entering afterwards
+    // get a later epoch, so the grace period of a snapshot always ends, however many threads keep emitting.
+    class rcu_domain_t
+    {
+    public:
+        using epoch_t = uint64_t;
+
+        // Read-side sections can be nested (e.g. a synchronous handler emitting another event): only the outermost one is recorded.
+        static void enter() noexcept;
+
+        // Return true when the outermost read-side section of the calling thread ends.
+        static bool leave() noexcept;
+
+        // Advance the global epoch, and return the epoch a snapshot replaced before the call has to be tagged with.
+        static epoch_t retire_epoch() noexcept;
+
+        // Oldest epoch held by a reader, the maximum epoch if no thread is reading.
+        static epoch_t oldest_reader_epoch() noexcept;
+    };
+
+    // Immutable snapshot of a value (read-copy-update): readers never lock nor copy it, and the writers (serialized by the caller)
+    // replace it with a single pointer store. The replaced snapshots are retired, and they are destroyed once their grace period ends
+    // (see rcu_domain_t): by the writer itself if no reader is left, otherwise by a reader leaving its read-side section later.
+    // A reader can also pin the snapshot it reads, to use it after its read-side section (e.g. from a task queued by an emit).
+    template <typename T>
+    class rcu_snapshot_t : private non_copyable, private non_moveable
+    {
+        struct node_t
+        {
+            explicit node_t(std::shared_ptr<const T> value) noexcept
+                : value{std::move(value)}
+            {
+            }
+
+            const std::shared_ptr<const T> value;
+            rcu_domain_t::epoch_t retired_epoch = 0;
+            node_t* next = nullptr;
+        };
+
+    public:
+        // Read-side section: the snapshot it got is not destroyed until the guard is.
+        class read_guard_t : private non_copyable, private non_moveable
+        {
+        public:
+            explicit read_guard_t(rcu_snapshot_t& snapshot) noexcept
+                : _snapshot{snapshot}
+            {
+                rcu_domain_t::enter();
+                _node = _snapshot._published.load();
+            }
+
+            ~read_guard_t() noexcept
+            {
+                if (rcu_domain_t::leave() && _snapshot._retired.load(std::memory_order_relaxed) != nullptr)
+                    _snapshot.reclaim();
+            }
+
+            const T* get() const noexcept
+            {
+                return _node ? _node->value.get() : nullptr;
+            }
+
+            std::shared_ptr<const T> pin() const noexcept
+            {
+                return _node ? _node->value : nullptr;
+            }
+
+        private:
+            rcu_snapshot_t& _snapshot;
+            const node_t* _node = nullptr;
+        };
+
+        rcu_snapshot_t() noexcept = default;
+
+        ~rcu_snapshot_t() noexcept
+        {
+            destroy(_retired.exchange(nullptr));
+            delete _current;
+        }
+
+        // Latest published snapshot, for the writers only.
+        const T* current() const noexcept
+        {
+            return _current ? _current->value.get() : nullptr;
+        }
+
+        void publish(std::unique_ptr<const T> value)
+        {
+            auto node = value ? std::make_unique<node_t>(std::shared_ptr<const T>(std::move(value))) : nullptr;
+
+            _published.store(node.get());
+            if (const auto retired = std::exchange(_current, node.release()))
+            {
+                retired->retired_epoch = rcu_domain_t::retire_epoch();
+                push(retired, retired);
+            }
+
+            reclaim();
+        }
+
+    private:
+        void push(node_t* first, node_t* last) noexcept
+        {
+            last->next = _retired.load();
+            while (!_retired.compare_exchange_weak(last->next, first))
+            {
+            }
+        }
+
+        void reclaim() noexcept
+        {
+            while (auto retired = _retired.exchange(nullptr))
+            {
+                // A reader that got a retired snapshot entered its read-side section before the snapshot was retired:
+                // its epoch is not later than the retired epoch of the snapshot.
+                const auto oldest_reader_epoch = rcu_domain_t::oldest_reader_epoch();
+
+                node_t* kept_first = nullptr;
+                node_t* kept_last = nullptr;
+                rcu_domain_t::epoch_t kept_epoch = 0;
+                while (retired != nullptr)
+                {
+                    const auto next = retired->next;
+                    if (retired->retired_epoch < oldest_reader_epoch)
+                    {
+                        delete retired;
+                    }
+                    else
+                    {
+                        retired->next = kept_first;
+                        kept_first = retired;
+                        kept_last = kept_last ? kept_last : retired;
+                        kept_epoch = std::max(kept_epoch, retired->retired_epoch);
+                    }
+
+                    retired = next;
+                }
+
+                if (kept_first == nullptr)
+                    return;
+
+                // The snapshots still in their grace period are reclaimed by the next reader leaving its read-side section,
+                // unless the readers holding them left before the snapshots were pushed back (they did not see them): in that case try again.
+                push(kept_first, kept_last);
+                if (rcu_domain_t::oldest_reader_epoch() <= kept_epoch)
+                    return;
+            }
+        }
+
+        static void destroy(node_t* node) noexcept
+        {
+            while (node != nullptr)
+                delete std::exchange(node, node->next);
+        }
+
+        std::atomic<const node_t*> _published{nullptr};
+        std::atomic<node_t*> _retired{nullptr}; // Lock-free stack of the retired snapshots.
+        node_t* _current = nullptr;             // Owner of the published snapshot, accessed by the writers only.
+    };
+
+    // State shared by the handlers queued by an emit: a pin of the handlers snapshot, which keeps the queued handlers alive
+    // even if they are removed meanwhile, and the payload. The queued tasks share it instead of owning each its handler.
+    // Each queued handler holds a reader of the payload until it is done with it, and so does emit while it can still run handlers inline:
+    // a consumer that finds itself the last reader takes the payload instead of copying it.
+    template <typename... Args>
+    struct emit_context_t
+    {
+        emit_context_t(std::shared_ptr<const handlers_list_t> handlers, std::tuple<Args...>&& payload, size_t readers) noexcept
+            : handlers{std::move(handlers)}
+            , payload{std::move(payload)}
+            , readers{readers}
+        {
+        }
+
+        // Read the payload, or take it if the caller is its last reader.
+        void apply(const handler_t<Args...>& h) noexcept
+        {
+            if (h.is_consumer() && readers.load(std::memory_order_acquire) == 1)
+                call_handler(h, std::move(payload));
+            else
+                call_handler(h, std::as_const(payload));
+        }
+
+        void release_reader() noexcept
+        {
+            readers.fetch_sub(1, std::memory_order_release);
+        }
+
+        const std::shared_ptr<const handlers_list_t> handlers;
+        std::tuple<Args...> payload;
+        std::atomic<size_t> readers;
+    };
+
+    // Handlers of an event, shared by the events map and by the channels bound to the event:
+    // an event erased from the map by remove_event() stays valid as long as a channel is bound to it.
+    //
+    // The handlers list is an immutable snapshot: adding or removing a handler publishes a new list,
+    // so that emitting the event never locks nor copies the handlers. The updates must be done with the events mutex held.
+    struct event_t
+    {
+        rcu_snapshot_t<handlers_list_t> handlers; // Null when the event has no handlers.
+
+        template <typename UpdateFunction>
+        void update_handlers(UpdateFunction&& update)
+        {
+            const auto current_handlers = handlers.current();
+            auto new_handlers = current_handlers ? std::make_unique<handlers_list_t>(*current_handlers) : std::make_unique<handlers_list_t>();
+            update(*new_handlers);
+
+            if (new_handlers->empty())
+                handlers.publish(nullptr);
+            else
+                handlers.publish(std::move(new_handlers));
+        }
+
+        void clear_handlers()
+        {
+            handlers.publish(nullptr);
+        }
+    };
+
+    // The events map is an immutable snapshot as well: adding or removing an event publishes a new copy of the map,
+    // so that looking up an event never locks. An event found in a snapshot stays valid as long as the snapshot is read.
+    using events_map_t = std::unordered_map<event_key_t, std::shared_ptr<event_t>, event_key_hash_t>;
+
 public:
+    /*!
+     * \class event_channel
+     * \brief Typed handle to an event of a tc::sdk::event_dispatcher.
+     *
+     * A channel is bound to an event name and to the exact list of its argument types once, by tc::sdk::event_dispatcher::channel:
+     * emitting an event through a channel does not build any string key nor look up any map, it only loads the handlers snapshot of that single event.
+     * Channels are cheap to copy, and all the channels of the same event share the same handlers with the name based APIs.
+     * Once the event is removed with tc::sdk::event_dispatcher::remove_event, the channel is detached from its name: it keeps working
+     * with the handlers added through it, while the handlers added afterwards by name belong to a new event (see tc::sdk::event_dispatcher::channel).
+     * A channel must not be used after its event_dispatcher has been destroyed. A default constructed event_channel is invalid.
+     */
+    template <typename... Args>
+    class event_channel
+    {
+    public:
+        event_channel() = default;
+
+        /*!
+         * \brief Check if the channel is bound to an event_dispatcher
+         */
+        bool is_valid() const
+        {
+            return _dispatcher != nullptr;
+        }
+
+        explicit operator bool() const
+        {
+            return is_valid();
+        }
+
+        /*!
+         * \brief Add a user defined handler to the event of the channel
+         * \param event_handler User defined event handler
+         * \param options Delivery mode of the handler
+         * \return Handler ID, 0 if the channel is invalid
+         *
+         * See tc::sdk::event_dispatcher::add_handler.
+         */
+        template <typename HandlerT>
+        auto add_handler(HandlerT&& event_handler, handler_options options = {}) const -> unsigned long
+        {
+            return is_valid() ? _dispatcher->template add_event_handler<Args...>(*_event, std::forward<HandlerT>(event_handler), options) : 0;
+        }
+
+        /*!
+         * \brief Emit the event of the channel
+         * \param args event handler arguments
+         * \return true if at least an event handler has been called
+         *
+         * The payload is shared by all the handlers, see tc::sdk::event_dispatcher::emit.
+         */
+        auto emit(Args... args) const -> bool
+        {
+            return is_valid() && _dispatcher->template dispatch<std::decay_t<Args>...>(*_event, std::forward<Args>(args)...);
+        }
+
+    private:
+        friend class event_dispatcher;
+
+        event_channel(event_dispatcher* dispatcher, std::shared_ptr<event_t> event)
+            : _dispatcher{dispatcher}
+            , _event{std::move(event)}
+        {
+        }
+
+        event_dispatcher* _dispatcher = nullptr;
+        std::shared_ptr<event_t> _event;
+    };
+
     /*!
      * \brief Constructor.
      *
@@ -83,6 +499,16 @@ public:
      */
     event_dispatcher() noexcept;
 
+    /*!
+     * \brief Constructor.
+     * \param executor External tc::sdk::thread_pool used to run the event handlers
+     *
+     * Creates a tc::sdk::event_dispatcher instance that runs the event handlers on the given executor instead of an internal thread pool,
+     * so that several components can share the same worker threads.
+     * The executor is neither started nor stopped by the event_dispatcher, and it must outlive the event_dispatcher.
+     */
+    explicit event_dispatcher(tc::sdk::thread_pool& executor) noexcept;
+
     /*!
      * \brief Destructor.
      *
@@ -94,59 +520,68 @@ public:
      * \brief Add a user defined handler to the specified event
      * \param event_name Event name
      * \tparam event_handler User defined event handler
+     * \param options Delivery mode of the handler
      * \return Handler ID
      *
-     * TODO!
+     * By default handlers are run on the thread pool. Cheap handlers (e.g. incrementing a counter) can be run inline by emit()
+     * with delivery_mode::synchronous, which saves the task allocation, the queue lock and the thread hop:
+     * synchronous handlers must not block, as they delay the emitting thread and the handlers that follow them,
+     * and they are run by emit() even before the event_dispatcher is started.
+     * Exceptions thrown by synchronous handlers are discarded, as the ones thrown by queued handlers.
+     * With delivery_mode::hybrid the dispatcher measures the handler and runs it inline only while its average cost
+     * stays within tc::sdk::event_dispatcher::get_hybrid_threshold.
+     * Declare the arguments of the handler as const references to read the payload shared by all the handlers of the event:
+     * arguments taken by value may require a copy of the payload for each call (see tc::sdk::event_dispatcher::emit).
      */
     template <typename... Args, typename HandlerT>
-    auto add_handler(std::string event_name, HandlerT&& event_handler) -> unsigned long
+    auto add_handler(std::string event_name, HandlerT&& event_handler, handler_options options = {}) -> unsigned long
     {
-        using WrapperT = typename tc::sdk::function_traits<HandlerT>::wrapper_t;
-
-        static_assert(std::is_same_v<void, std::invoke_result_t<HandlerT, Args...>>,
-                      "\nevent_handler must return void!");
-
-        static_assert(std::is_same_v<std::function<void(std::decay_t<Args>...)>, WrapperT>,
-                      "\nevent_handler arguments mismatch in add_handler()!"
-                      "\nplease match your handler arguments (input parameters) with your declaration (template specification)");
-
-        const auto event_handler_id = get_event_handler_id<Args...>(std::move(event_name));
+        return add_event_handler<Args...>(*get_event<Args...>(std::move(event_name)), std::forward<HandlerT>(event_handler), options);
+    }
 
-        std::unique_lock handlers_lock(_handlers_mutex);
-        _handlers[event_handler_id].emplace_back(std::make_unique<handler_t<Args...>>(++handler_id, std::move(event_handler)));
-        return handler_id;
+    /*!
+     * \brief Get the typed channel of the specified event
+     * \param event_name Event name
+     * \tparam Args event handler arguments
+     * \return tc::sdk::event_dispatcher::event_channel bound to the event
+     *
+     * The event is looked up (or created) only once, here: the returned channel then emits the event without any string or map work.
+     */
+    template <typename... Args>
+    auto channel(std::string event_name) -> event_channel<Args...>
+    {
+        return event_channel<Args...>(this, get_event<Args...>(std::move(event_name)));
     }
 
     /*!
-     * \brief Add a user defined handler to the specified event.
+     * \brief Emit the specified event
      * \param event_name Event name
-     * \tparam args event handler arguments
+     * \param args event handler arguments
      * \return true if the event has been emitted succesfully and at least an event handler has been called.
      *
-     * TODO!
+     * The arguments are moved into a single payload, allocated once per emit and shared by all the queued handlers of the event:
+     * the handlers taking const references get a const reference to it, so the payload is copied at most once (when emit is given an lvalue),
+     * whatever the number of handlers. Move large payloads (e.g. frames or vectors) into emit to avoid any copy,
+     * and declare the handler arguments as const references to read them in place.
+     * Handlers taking arguments by value (other than trivially copyable ones) or by non const reference own their payload instead:
+     * the last handler to read the payload gets it moved into its arguments, while each of the other ones gets a copy of it.
+     * A single such handler never copies the payload, but N of them copy it N - 1 times (N if a queued handler is still reading it).
+     * The event is looked up without locking, but a channel (see tc::sdk::event_dispatcher::channel) also saves building its key and hashing its name.
      */
     template <typename... Args>
     auto emit(std::string event_name, Args... args) -> bool
     {
-        const auto event_handler_id = get_event_handler_id<Args...>(std::move(event_name));
-
-        std::unique_lock handlers_lock(_handlers_mutex);
-        if (!_handlers.contains(event_handler_id))
+        // The events map snapshot is read until the event is dispatched: it keeps the event alive even if it is removed meanwhile.
+        const rcu_snapshot_t<events_map_t>::read_guard_t events_guard(_events);
+        const auto events = events_guard.get();
+        if (events == nullptr)
             return false;
 
-        std::vector<std::shared_ptr<base_handler_t>> event_handlers = _handlers.at(event_handler_id);
-        handlers_lock.unlock();
-
-        for (auto&& h : event_handlers)
-        {
-            const std::function<void()> event = [e = std::static_pointer_cast<handler_t<Args...>>(h), args...] {
-                return std::invoke(&handler_t<Args...>::call, e.get(), args...);
-            };
-
-            _tp.run(std::move(event));
-        }
+        const auto it = events->find(make_event_key<Args...>(std::move(event_name)));
+        if (it == events->end())
+            return false;
 
-        return true;
+        return dispatch<std::decay_t<Args>...>(*it->second, std::forward<Args>(args)...);
     }
 
     /*!
@@ -160,12 +595,27 @@ public:
      * \brief remove the event with the given event_name and all its associated handlers
      * \param event_name Event name
      * \return true if removed successfully
+     *
+     * The event is erased with all its signatures, so that short lived event names do not accumulate.
+     * See tc::sdk::event_dispatcher::event_channel for the channels bound to a removed event.
      */
     auto remove_event(std::string event_name) -> bool;
 
+    /*!
+     * \brief Set the maximum estimated cost of the delivery_mode::hybrid handlers run inline
+     * \param threshold Handlers whose average execution time exceeds the threshold are run on the thread pool
+     */
+    void set_hybrid_threshold(tc::sdk::clock::duration threshold);
+
+    /*!
+     * \brief Get the maximum estimated cost of the delivery_mode::hybrid handlers run inline
+     * \return The threshold set with tc::sdk::event_dispatcher::set_hybrid_threshold (10 microseconds by default).
+     */
+    tc::sdk::clock::duration get_hybrid_threshold() const;
+
     /*!
      * \brief Starts the event_dispatcher and the underlying tc::sdk::thread_pool with the given number of threads
-     * \param num_threads Number of threads of the underlying tc::sdk::thread_pool
+     * \param num_threads Number of threads of the underlying tc::sdk::thread_pool (ignored when running on an external executor)
      * \return true if started successfully
      */
     auto start(const unsigned int num_threads = 1) -> bool;
@@ -173,26 +623,168 @@ public:
     /*!
      * \brief Stop the event_dispatcher and the underlying tc::sdk::thread_pool
      * \return true if stopped successfully
+     *
+     * When running on an external executor, the handlers already dispatched to it are not discarded.
      */
     auto stop() -> bool;
 
 private:
-    std::unordered_map<std::string, std::vector<std::shared_ptr<base_handler_t>>> _handlers;
-    std::mutex _handlers_mutex;
-    tc::sdk::thread_pool _tp;
+    rcu_snapshot_t<events_map_t> _events; // Null until the first event is added.
+    std::mutex _events_mutex;             // Serializes the updates of the events map and of the handlers lists, and the handlers ID counter: emitting an event never locks it.
+    std::optional<tc::sdk::thread_pool> _owned_tp; // Empty when running on an external executor.
+    tc::sdk::thread_pool& _tp;
+    std::atomic<bool> _is_running;
+    std::atomic<tc::sdk::clock::rep> _hybrid_threshold;
     static unsigned long handler_id;
 
     template <typename... Args>
-    constexpr auto get_event_handler_id(std::string&& event_name) const
+    static auto make_event_key(std::string&& event_name) -> event_key_t
     {
-        if constexpr (sizeof...(Args) == 0)
+        return event_key_t{std::move(event_name), std::type_index(typeid(signature_t<std::decay_t<Args>...>))};
+    }
+
+    template <typename... Args>
+    auto get_event(std::string&& event_name) -> std::shared_ptr<event_t>
+    {
+        auto event_key = make_event_key<Args...>(std::move(event_name));
+
+        std::scoped_lock events_lock(_events_mutex);
+        const auto events = _events.current();
+        if (events != nullptr)
         {
-            return std::move(event_name);
+            const auto it = events->find(event_key);
+            if (it != events->end())
+                return it->second;
         }
+
+        auto new_events = events ? std::make_unique<events_map_t>(*events) : std::make_unique<events_map_t>();
+        auto event = std::make_shared<event_t>();
+        new_events->emplace(std::move(event_key), event);
+        _events.publish(std::move(new_events));
+        return event;
+    }
+
+    template <typename... Args, typename HandlerT>
+    auto add_event_handler(event_t& event, HandlerT&& event_handler, handler_options options) -> unsigned long
+    {
+        using WrapperT = typename tc::sdk::function_traits<HandlerT>::wrapper_t;
+
+        static_assert(std::is_same_v<void, std::invoke_result_t<HandlerT, Args...>>,
+                      "\nevent_handler must return void!");
+
+        static_assert(std::is_same_v<std::function<void(std::decay_t<Args>...)>, WrapperT>,
+                      "\nevent_handler arguments mismatch in add_handler()!"
+                      "\nplease match your handler arguments (input parameters) with your declaration (template specification)");
+
+        // Handlers are stored with the decayed argument types, the ones the events are emitted with: the handlers that only read their arguments
+        // are bound to the shared payload, the consumers get a payload of their own (see handler_t).
+        using AdapterT = handler_adapter_t<typename tc::sdk::function_traits<HandlerT>::arguments_t>;
+        using HandlerFunctionT = std::conditional_t<AdapterT::is_reader, typename handler_t<std::decay_t<Args>...>::reader_t, typename handler_t<std::decay_t<Args>...>::consumer_t>;
+
+        HandlerFunctionT f;
+        if constexpr (AdapterT::is_reader)
+            f = std::forward<HandlerT>(event_handler);
         else
+            f = AdapterT::consumer(std::forward<HandlerT>(event_handler));
+
+        std::scoped_lock events_lock(_events_mutex);
+        auto h = std::make_shared<handler_t<std::decay_t<Args>...>>(++handler_id, options, std::move(f));
+        event.update_handlers([&h](handlers_list_t& handlers) { handlers.emplace_back(std::move(h)); });
+        return handler_id;
+    }
+
+    template <typename... Args>
+    auto dispatch(event_t& event, Args... args) -> bool
+    {
+        const rcu_snapshot_t<handlers_list_t>::read_guard_t handlers_guard(event.handlers);
+        const auto event_handlers = handlers_guard.get();
+        if (event_handlers == nullptr)
+            return false;
+
+        // The payload is moved into the context shared by the queued handlers when the first of them is found (inline handlers only need it while emit runs):
+        // all the handlers read the same payload, so it is never copied for them whatever the number of handlers.
+        // The consumers get a copy, but the last reader of the payload takes it: a single consumer never copies it.
+        const auto& handlers = *event_handlers;
+        const auto inline_end = static_cast<size_t>(std::find_if(handlers.rbegin(), handlers.rend(), [](auto&& h) { return h->delivery != delivery_mode::queued; }).base() - handlers.begin());
+        std::tuple<Args...> local_payload(std::move(args)...);
+        std::shared_ptr<emit_context_t<Args...>> context;
+
+        for (size_t i = 0; i < handlers.size(); ++i)
+        {
+            const auto& handler = static_cast<const handler_t<Args...>&>(*handlers[i]);
+            if (i < inline_end && is_inline(handler))
+            {
+                if (i + 1 < handlers.size())
+                    call_handler(handler, context ? std::as_const(context->payload) : std::as_const(local_payload));
+                else if (context)
+                    context->apply(handler);
+                else
+                    call_handler(handler, std::move(local_payload));
+
+                continue;
+            }
+
+            // Past the last handler that can run inline, emit gives its reader to the remaining handlers, which are all queued.
+            size_t new_readers = 0;
+            if (i < inline_end)
+                new_readers = 1;
+            else if (i == inline_end)
+                new_readers = handlers.size() - inline_end - 1;
+
+            if (!context)
+                context = std::make_shared<emit_context_t<Args...>>(handlers_guard.pin(), std::move(local_payload), new_readers + 1);
+            else if (new_readers != 0)
+                context->readers.fetch_add(new_readers, std::memory_order_relaxed);
+
+            // No result is needed: the capture (the context and a handler pointer) fits the inline storage of the task, so queueing a handler does not allocate.
+            _tp.execute([context, handler = &handler] {
+                context->apply(*handler);
+                context->release_reader();
+            });
+        }
+
+        if (context && inline_end == handlers.size())
+            context->release_reader();
+
+        return true;
+    }
+
+    bool is_inline(const base_handler_t& h) const
+    {
+        switch (h.delivery)
+        {
+        case delivery_mode::synchronous:
+            return true;
+        case delivery_mode::hybrid:
+            return h.cost.load(std::memory_order_relaxed) <= _hybrid_threshold.load(std::memory_order_relaxed);
+        default:
+            return false;
+        }
+    }
+
+    // Exceptions are discarded, so that a failing handler does not prevent the following ones from being run.
+    template <typename... Args, typename PayloadT>
+    static void call_handler(const handler_t<Args...>& h, PayloadT&& payload) noexcept
+    {
+        try
+        {
+            if (h.delivery != delivery_mode::hybrid)
+            {
+                h.call(std::forward<PayloadT>(payload));
+                return;
+            }
+
+            // The cost of the hybrid handlers is measured wherever they run, so that a handler moved to the thread pool
+            // while it was slow is run inline again once it gets cheap.
+            const auto start_time = tc::sdk::clock::now();
+            h.call(std::forward<PayloadT>(payload));
+            const auto duration = (tc::sdk::clock::now() - start_time).count();
+
+            const auto cost = h.cost.load(std::memory_order_relaxed);
+            h.cost.store(cost + (duration - cost) / 8, std::memory_order_relaxed);
+        }
+        catch (...)
         {
-            auto args_hash = std::to_string((typeid(std::decay_t<Args>).hash_code() + ...));
-            return std::move(event_name + args_hash);
         }
     }
 };
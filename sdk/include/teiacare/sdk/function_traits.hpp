@@ -15,6 +15,7 @@
 #pragma once
 
 #include <functional>
+#include <tuple>
 
 /**
  * @cond SKIP_DOXYGEN
@@ -25,6 +26,7 @@ template <typename RetType, typename... Args>
 struct function_wrapper
 {
     using return_t = RetType;
+    using arguments_t = std::tuple<Args...>;
     using function_t = RetType(std::decay_t<Args>...);
     using wrapper_t = std::function<function_t>;
 };
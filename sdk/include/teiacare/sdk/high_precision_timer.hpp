@@ -15,6 +15,7 @@
 #pragma once
 
 #include <teiacare/sdk/clock.hpp>
+#include <teiacare/sdk/clock_source.hpp>
 #include <teiacare/sdk/non_copyable.hpp>
 #include <teiacare/sdk/non_moveable.hpp>
 #include <teiacare/sdk/task.hpp>
@@ -44,6 +45,14 @@ public:
      */
     explicit high_precision_timer();
 
+    /*!
+     * \brief Constructor
+     * \param clock clock_source used to read the current time and to wait for the callback start times
+     *
+     * Creates a tc::sdk::high_precision_timer instance driven by the given clock (e.g. a tc::sdk::manual_clock).
+     */
+    explicit high_precision_timer(std::shared_ptr<tc::sdk::clock_source> clock);
+
     /*!
      * \brief Destructor
      *
@@ -108,6 +117,7 @@ protected:
     void update_next_start_time();
 
 private:
+    std::shared_ptr<tc::sdk::clock_source> _clock;
     bool _is_running;
     clock::duration _interval;
     std::unique_ptr<tc::sdk::task> _task;
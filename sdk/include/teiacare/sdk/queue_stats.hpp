@@ -0,0 +1,131 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <teiacare/sdk/clock.hpp>
+#include <teiacare/sdk/config.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace tc::sdk
+{
+/*!
+ * \brief Check if queue instrumentation has been compiled in.
+ *
+ * Queue counters are enabled by configuring the project with the TC_ENABLE_QUEUE_STATS CMake option,
+ * which is recorded in the generated teiacare/sdk/config.hpp header installed with the library.
+ * When disabled, all the counters compile out and tc::sdk::queue_stats snapshots are always zero initialized.
+ */
+#if defined(TC_ENABLE_QUEUE_STATS)
+inline constexpr bool queue_stats_enabled = true;
+#else
+inline constexpr bool queue_stats_enabled = false;
+#endif
+
+/*!
+ * \struct queue_stats
+ * \brief Snapshot of the counters of an instrumented queue.
+ *
+ * A snapshot can be retrieved from tc::sdk::blocking_queue::stats() and tc::sdk::thread_pool::stats().
+ */
+struct queue_stats
+{
+    size_t size = 0;                               //!< Number of items in the queue when the snapshot was taken.
+    size_t peak_size = 0;                          //!< Maximum number of items held by the queue (high-water mark).
+    uint64_t push_count = 0;                       //!< Total number of items pushed.
+    uint64_t pop_count = 0;                        //!< Total number of items popped.
+    tc::sdk::clock::duration push_blocked_time{0}; //!< Total time spent by producers waiting on a full queue.
+    tc::sdk::clock::duration pop_blocked_time{0};  //!< Total time spent by consumers waiting on an empty queue.
+};
+
+/**
+ * @cond SKIP_DOXYGEN
+ */
+namespace detail
+{
+// All the functions must be called with the owning queue lock held.
+class queue_stats_recorder
+{
+public:
+#if defined(TC_ENABLE_QUEUE_STATS)
+    void on_push(size_t size)
+    {
+        ++_stats.push_count;
+        _stats.peak_size = std::max(_stats.peak_size, size);
+    }
+
+    void on_pop()
+    {
+        ++_stats.pop_count;
+    }
+
+    tc::sdk::clock::time_point wait_begin() const
+    {
+        return tc::sdk::clock::now();
+    }
+
+    void on_push_blocked(tc::sdk::clock::time_point wait_begin)
+    {
+        _stats.push_blocked_time += tc::sdk::clock::now() - wait_begin;
+    }
+
+    void on_pop_blocked(tc::sdk::clock::time_point wait_begin)
+    {
+        _stats.pop_blocked_time += tc::sdk::clock::now() - wait_begin;
+    }
+
+    queue_stats snapshot(size_t size) const
+    {
+        queue_stats s = _stats;
+        s.size = size;
+        return s;
+    }
+
+private:
+    queue_stats _stats;
+#else
+    void on_push(size_t)
+    {
+    }
+
+    void on_pop()
+    {
+    }
+
+    tc::sdk::clock::time_point wait_begin() const
+    {
+        return {};
+    }
+
+    void on_push_blocked(tc::sdk::clock::time_point)
+    {
+    }
+
+    void on_pop_blocked(tc::sdk::clock::time_point)
+    {
+    }
+
+    queue_stats snapshot(size_t) const
+    {
+        return {};
+    }
+#endif
+};
+}
+/** @endcond */
+
+}
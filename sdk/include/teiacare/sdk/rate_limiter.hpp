@@ -15,10 +15,12 @@
 #pragma once
 
 #include <teiacare/sdk/clock.hpp>
+#include <teiacare/sdk/clock_source.hpp>
 #include <teiacare/sdk/non_copyable.hpp>
 #include <teiacare/sdk/non_moveable.hpp>
 
 #include <chrono>
+#include <memory>
 #include <type_traits>
 
 namespace tc::sdk
@@ -38,6 +40,15 @@ public:
      */
     explicit rate_limiter(size_t rate);
 
+    /*!
+     * \brief Constructor
+     * \param rate set the required rate value
+     * \param clock clock_source used to read the current time and to wait for the next frame
+     *
+     * Creates a tc::sdk::rate_limiter instance with the given rate, driven by the given clock (e.g. a tc::sdk::manual_clock).
+     */
+    explicit rate_limiter(size_t rate, std::shared_ptr<tc::sdk::clock_source> clock);
+
     /*!
      * \brief Destructor
      *
@@ -54,6 +65,7 @@ public:
 
 private:
     using duration_rep = double;
+    std::shared_ptr<tc::sdk::clock_source> _clock;
     const std::chrono::duration<duration_rep> time_between_frames; // 1/rate
     std::chrono::time_point<tc::sdk::clock, std::remove_const_t<decltype(time_between_frames)>> tp;
 };
@@ -16,7 +16,8 @@
 
 #include <teiacare/sdk/non_copyable.hpp>
 
-#include <memory>
+#include <cstddef>
+#include <new>
 #include <type_traits>
 #include <utility>
 
@@ -28,10 +29,17 @@ namespace tc::sdk
  *
  * This class represents a callable object. Can be initialized with any invocable type that supports operator().
  * Internally the class implements a type-erasure idiom to accept any callable signature without exposing it to the outside.
+ * Callable objects up to tc::sdk::task::inline_storage_size bytes (e.g. lambdas capturing a few pointers or a std::shared_ptr)
+ * that are nothrow move constructible are stored inline, without any heap allocation.
  */
 class task : private tc::sdk::non_copyable
 {
 public:
+    /*!
+     * \brief Size of the inline storage used to avoid heap allocations for small callable objects.
+     */
+    static constexpr size_t inline_storage_size = 6 * sizeof(void*);
+
     /*!
      * \brief Default constructor.
      * \param callable Callable parameterless object wrapped within this task instance.
@@ -41,14 +49,40 @@ public:
      */
     template <typename CallableType>
     explicit task(CallableType&& callable)
-        : _callable(std::make_unique<task_impl<CallableType>>(std::move(callable)))
     {
+        using callable_type = std::decay_t<CallableType>;
+        using impl_type = task_impl<callable_type>;
+
+        if constexpr (is_inline<callable_type>)
+        {
+            _callable = ::new (static_cast<void*>(_storage)) impl_type(std::forward<CallableType>(callable));
+            _is_inline = true;
+        }
+        else
+        {
+            _callable = new impl_type(std::forward<CallableType>(callable));
+        }
     }
 
     /*!
      * \brief Move Constructor. Move a tc::sdk::task instance into another one.
      */
-    task(task&& other) noexcept = default;
+    task(task&& other) noexcept
+        : _is_inline{other._is_inline}
+    {
+        if (_is_inline)
+        {
+            _callable = other._callable->move_to(_storage);
+            other.destroy();
+        }
+        else
+        {
+            _callable = other._callable;
+        }
+
+        other._callable = nullptr;
+        other._is_inline = false;
+    }
 
     /*!
      * \brief Move assignment operator marked as deleted.
@@ -60,7 +94,10 @@ public:
      *
      * Destructs this.
      */
-    ~task() noexcept = default;
+    ~task() noexcept
+    {
+        destroy();
+    }
 
     /*!
      * \brief invoke
@@ -87,13 +124,15 @@ private:
     {
         virtual ~task_base() = default;
         virtual void invoke() = 0;
+        virtual task_base* move_to(void* storage) noexcept = 0;
     };
 
     template <typename CallableType>
     struct task_impl : public task_base
     {
-        explicit task_impl(CallableType callable)
-            : callable(std::move(callable))
+        template <typename T>
+        explicit task_impl(T&& callable)
+            : callable(std::forward<T>(callable))
         {
         }
 
@@ -104,11 +143,34 @@ private:
             callable();
         }
 
+        task_base* move_to(void* storage) noexcept override
+        {
+            if constexpr (std::is_nothrow_move_constructible_v<CallableType>)
+                return ::new (storage) task_impl(std::move(callable));
+            else
+                return nullptr; // Never called: only nothrow move constructible callables are stored inline.
+        }
+
     private:
         CallableType callable;
     };
 
-    std::unique_ptr<task_base> _callable;
+    template <typename CallableType>
+    static constexpr bool is_inline = sizeof(task_impl<CallableType>) <= inline_storage_size
+        && alignof(task_impl<CallableType>) <= alignof(std::max_align_t)
+        && std::is_nothrow_move_constructible_v<CallableType>;
+
+    void destroy() noexcept
+    {
+        if (_is_inline)
+            _callable->~task_base();
+        else
+            delete _callable;
+    }
+
+    alignas(std::max_align_t) std::byte _storage[inline_storage_size];
+    task_base* _callable = nullptr;
+    bool _is_inline = false;
 };
 
 }
@@ -15,20 +15,127 @@
 #pragma once
 
 #include <teiacare/sdk/clock.hpp>
+#include <teiacare/sdk/clock_source.hpp>
+#include <teiacare/sdk/datetime/cron_schedule.hpp>
 #include <teiacare/sdk/non_copyable.hpp>
 #include <teiacare/sdk/non_moveable.hpp>
 #include <teiacare/sdk/task.hpp>
 #include <teiacare/sdk/thread_pool.hpp>
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
 #include <future>
-#include <map>
+#include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace tc::sdk
 {
+/**
+ * @cond SKIP_DOXYGEN
+ */
+namespace detail
+{
+class timer_queue;
+class timerfd_waiter;
+template <typename T>
+class slot_pool;
+
+// Coroutine started eagerly and destroyed when it completes: its result is reported by the coroutine body itself.
+struct detached_coroutine
+{
+    struct promise_type
+    {
+        detached_coroutine get_return_object() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void return_void() noexcept
+        {
+        }
+
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+
+// Resumes a suspended coroutine exactly once: when it is called, or as cancelled when it is destroyed without having been called
+// (e.g. when its task is discarded by task_scheduler::stop), so that the coroutine frame is never leaked.
+class coroutine_resumer
+{
+public:
+    coroutine_resumer(std::coroutine_handle<> coroutine, bool& is_cancelled) noexcept
+        : _coroutine{coroutine}
+        , _is_cancelled{&is_cancelled}
+    {
+    }
+
+    coroutine_resumer(coroutine_resumer&& other) noexcept
+        : _coroutine{std::exchange(other._coroutine, nullptr)}
+        , _is_cancelled{other._is_cancelled}
+    {
+    }
+
+    coroutine_resumer& operator=(coroutine_resumer&&) = delete;
+
+    ~coroutine_resumer()
+    {
+        if (_coroutine)
+        {
+            *_is_cancelled = true;
+            _coroutine.resume();
+        }
+    }
+
+    void operator()()
+    {
+        std::exchange(_coroutine, nullptr).resume();
+    }
+
+private:
+    std::coroutine_handle<> _coroutine;
+    bool* _is_cancelled;
+};
+
+template <typename Awaitable>
+struct awaiter_of
+{
+    using type = Awaitable;
+};
+
+template <typename Awaitable>
+    requires requires(Awaitable a) { std::move(a).operator co_await(); }
+struct awaiter_of<Awaitable>
+{
+    using type = decltype(std::declval<Awaitable>().operator co_await());
+};
+
+template <typename Awaitable>
+using await_result_t = decltype(std::declval<typename awaiter_of<Awaitable>::type&>().await_resume());
+}
+/** @endcond */
+
 /*!
  * \class task_scheduler
  * \brief Task Scheduler that can launch tasks on based several time-based policies
@@ -42,110 +149,476 @@ public:
     using delay_t = tc::sdk::clock::duration;
     using interval_t = tc::sdk::clock::duration;
 
+    /*!
+     * \brief Data structure used to keep track of the scheduled tasks.
+     */
+    enum class timer_backend
+    {
+        ordered_map, //!< Tasks ordered by start time: O(log n) insert and cancel, exact expiration time.
+        timing_wheel //!< Hierarchical timing wheel: O(1) insert and cancel, expiration rounded up to the wheel resolution.
+    };
+
+    /*!
+     * \brief Mechanism used by the scheduler thread to wait for the next task start time, or for new submissions.
+     */
+    enum class wakeup_backend
+    {
+        condition_variable, //!< Portable std::condition_variable wait, driven by the tc::sdk::clock_source of the scheduler.
+        timerfd             //!< Linux only: absolute CLOCK_MONOTONIC timerfd deadline and eventfd notifications, waited in epoll.
+    };
+
+    /*!
+     * \class task_handle
+     * \brief Lightweight reference to a scheduled task.
+     *
+     * A task_handle is returned by all the scheduling APIs (tc::sdk::task_scheduler::at, tc::sdk::task_scheduler::in,
+     * tc::sdk::task_scheduler::every), including the tasks started without a task_id.
+     * It is made of the index of the task slot in the scheduler and of the slot generation,
+     * so that all the handle based APIs are O(1) and never allocate.
+     * Once the task is removed, or a one-shot task is run, the handle expires:
+     * the handle based APIs are safe to call on expired handles and simply return false or std::nullopt.
+     * A default constructed task_handle is invalid.
+     */
+    class task_handle
+    {
+    public:
+        task_handle() = default;
+
+        /*!
+         * \brief Check if the handle has been returned by a successful scheduling call.
+         *
+         * A valid handle may nonetheless be expired: use tc::sdk::task_scheduler::is_scheduled to check it.
+         */
+        bool is_valid() const
+        {
+            return _generation != 0;
+        }
+
+        explicit operator bool() const
+        {
+            return is_valid();
+        }
+
+        bool operator==(const task_handle&) const = default;
+
+    private:
+        friend class task_scheduler;
+
+        task_handle(uint32_t index, uint32_t generation)
+            : _index{index}
+            , _generation{generation}
+        {
+        }
+
+        uint32_t _index = 0;
+        uint32_t _generation = 0;
+    };
+
+    /*!
+     * \class task_future
+     * \brief std::future of a one-shot task, along with the tc::sdk::task_scheduler::task_handle of the task.
+     */
+    template <typename T>
+    class task_future : public std::future<T>
+    {
+    public:
+        task_future(std::future<T>&& future, task_handle handle)
+            : std::future<T>{std::move(future)}
+            , _handle{handle}
+        {
+        }
+
+        /*!
+         * \brief Handle of the scheduled task.
+         */
+        task_handle handle() const
+        {
+            return _handle;
+        }
+
+    private:
+        task_handle _handle;
+    };
+
+    /*!
+     * \brief Behaviour of a recursive task when it has to be run while its previous run is still in progress.
+     */
+    enum class overlap_policy
+    {
+        allow,   //!< Run the task concurrently with its previous runs (default).
+        skip,    //!< Skip the run: the task runs again at its next interval.
+        coalesce //!< Run the task again as soon as its current run completes: all the overlapping runs are merged into a single one.
+    };
+
+    /*!
+     * \struct overlap_stats
+     * \brief Counters of the overlapping runs of a recursive task.
+     */
+    struct overlap_stats
+    {
+        uint64_t skipped_runs = 0;   //!< Runs skipped with overlap_policy::skip.
+        uint64_t coalesced_runs = 0; //!< Runs merged into a pending run with overlap_policy::coalesce.
+    };
+
+    /*!
+     * \brief Offset applied to the first start time of the recursive tasks, in order to spread them across their interval.
+     */
+    enum class phase_spreading
+    {
+        none,   //!< Recursive tasks start at their scheduled time (default).
+        jitter, //!< Random offset, uniformly distributed between zero and the task interval.
+        hash    //!< Deterministic offset between zero and the task interval, computed from the task_id (or from the task slot for the tasks without a task_id).
+    };
+
+    /*!
+     * \struct dispatch_stats
+     * \brief Counters of the tasks dispatched to the thread pool by the scheduler thread.
+     *
+     * A tick is a wakeup of the scheduler thread that dispatches at least one task:
+     * the tasks_per_tick histogram shows how evenly the load is spread over time.
+     */
+    struct dispatch_stats
+    {
+        static constexpr size_t histogram_size = 16;
+
+        uint64_t wakeups = 0;                                  //!< Wakeups of the scheduler thread.
+        uint64_t ticks = 0;                                    //!< Wakeups that dispatched at least one task.
+        uint64_t dispatched_tasks = 0;                         //!< Tasks dispatched to the thread pool.
+        uint64_t max_tasks_per_tick = 0;                       //!< Maximum number of tasks dispatched in a single tick.
+        std::array<uint64_t, histogram_size> tasks_per_tick{}; //!< tasks_per_tick[n] counts the ticks that dispatched from 2^n to 2^(n+1)-1 tasks (the last bucket is unbounded).
+    };
+
+    /*!
+     * \struct duration_histogram
+     * \brief Fixed-size histogram of durations, with exponential buckets.
+     */
+    struct duration_histogram
+    {
+        static constexpr size_t buckets_count = 32;
+
+        uint64_t count = 0;                             //!< Number of recorded durations.
+        tc::sdk::clock::duration total{0};              //!< Sum of the recorded durations.
+        tc::sdk::clock::duration max{0};                //!< Maximum recorded duration.
+        std::array<uint64_t, buckets_count> buckets{}; //!< buckets[0] counts the durations below 1us, buckets[n] the durations from 2^(n-1)us to 2^n us (the last bucket is unbounded).
+
+        /*!
+         * \brief Mean of the recorded durations (zero if no duration has been recorded).
+         */
+        tc::sdk::clock::duration mean() const;
+
+        /*!
+         * \brief Approximate percentile of the recorded durations.
+         * \param p percentile, between 0 and 1.
+         * \return The upper bound of the bucket holding the given percentile (capped to the maximum recorded duration).
+         */
+        tc::sdk::clock::duration percentile(double p) const;
+    };
+
+    /*!
+     * \struct task_stats
+     * \brief Execution statistics of a task, see tc::sdk::task_scheduler::set_task_stats_enabled.
+     */
+    struct task_stats
+    {
+        duration_histogram lateness; //!< Delay between the scheduled and the actual start time of each run.
+        duration_histogram duration; //!< Execution duration of each run.
+        uint64_t missed_periods = 0; //!< Periods of a recursive task skipped because the task has been run more than one interval late.
+    };
+
+    /*!
+     * \struct retry_policy
+     * \brief Backoff strategy of the operations started with tc::sdk::task_scheduler::retry.
+     *
+     * The delay before attempt N + 1 is initial_delay * multiplier^(N - 1), capped to max_delay.
+     * With a non zero jitter, each delay is drawn uniformly in [delay * (1 - jitter), delay],
+     * so that clients failing at the same time do not retry in lockstep (jitter = 1 is the so called "full jitter").
+     */
+    struct retry_policy
+    {
+        size_t max_attempts = 3;                                                 //!< Maximum number of attempts, including the first one (0 for no limit).
+        tc::sdk::clock::duration initial_delay = std::chrono::milliseconds(100); //!< Delay between the first and the second attempt.
+        double multiplier = 2.0;                                                 //!< Factor applied to the delay after each failed attempt.
+        tc::sdk::clock::duration max_delay = std::chrono::seconds(30);           //!< Upper bound of the delay between two attempts.
+        double jitter = 0.0;                                                     //!< Randomized fraction of each delay, in the range [0, 1].
+        std::optional<tc::sdk::clock::duration> deadline;                        //!< Overall time budget, from the first attempt: no attempt starts after it expires.
+    };
+
 private:
+    // Recorded by the thread pool workers without any lock.
+    struct duration_counters
+    {
+        std::atomic<uint64_t> count{0};
+        std::atomic<tc::sdk::clock::rep> total{0};
+        std::atomic<tc::sdk::clock::rep> max{0};
+        std::array<std::atomic<uint64_t>, duration_histogram::buckets_count> buckets{};
+
+        void record(tc::sdk::clock::duration d);
+        duration_histogram snapshot() const;
+    };
+
+    struct task_stats_counters
+    {
+        duration_counters lateness;
+        duration_counters duration;
+        std::atomic<uint64_t> missed_periods{0};
+    };
+
+    // Shared between the scheduler thread and the thread pool workers running the task.
+    struct task_state
+    {
+        template <typename FunctionType>
+        explicit task_state(FunctionType&& f)
+            : task{std::forward<FunctionType>(f)}
+            , run_flags{0}
+        {
+        }
+
+        tc::sdk::task task;
+        std::atomic<uint32_t> run_flags;
+        std::unique_ptr<task_stats_counters> stats; // Set before the task is scheduled, if the task statistics are enabled.
+    };
+
     class schedulable_task : private non_copyable, private non_moveable
     {
     public:
         template <typename FunctionType>
         explicit schedulable_task(FunctionType&& f)
-            : _task{std::make_shared<tc::sdk::task>(std::forward<FunctionType>(f))}
-            , _is_enabled{true}
+            : _state{std::make_shared<task_state>(std::forward<FunctionType>(f))}
         {
         }
 
         template <typename FunctionType>
-        explicit schedulable_task(FunctionType&& f, size_t hash)
-            : _task{std::make_shared<tc::sdk::task>(std::forward<FunctionType>(f))}
-            , _is_enabled{true}
-            , _hash{hash}
+        explicit schedulable_task(FunctionType&& f, std::string&& id)
+            : _state{std::make_shared<task_state>(std::forward<FunctionType>(f))}
+            , _id{std::move(id)}
         {
         }
 
         template <typename FunctionType>
         explicit schedulable_task(FunctionType&& f, tc::sdk::clock::duration interval)
-            : _task{std::make_shared<tc::sdk::task>(std::forward<FunctionType>(f))}
-            , _is_enabled{true}
+            : _state{std::make_shared<task_state>(std::forward<FunctionType>(f))}
             , _interval{interval}
         {
         }
 
         template <typename FunctionType>
-        explicit schedulable_task(FunctionType&& f, size_t hash, tc::sdk::clock::duration interval)
-            : _task{std::make_shared<tc::sdk::task>(std::forward<FunctionType>(f))}
-            , _is_enabled{true}
+        explicit schedulable_task(FunctionType&& f, std::string&& id, tc::sdk::clock::duration interval)
+            : _state{std::make_shared<task_state>(std::forward<FunctionType>(f))}
             , _interval{interval}
-            , _hash{hash}
+            , _id{std::move(id)}
         {
         }
 
-        ~schedulable_task()
+        template <typename FunctionType>
+        explicit schedulable_task(FunctionType&& f, const tc::sdk::cron_schedule& schedule)
+            : _state{std::make_shared<task_state>(std::forward<FunctionType>(f))}
+            , _schedule{schedule}
         {
         }
 
-        schedulable_task(schedulable_task&& other) noexcept
-            : _task{std::move(other._task)}
-            , _is_enabled{std::move(other._is_enabled)}
-            , _interval{std::move(other._interval)}
-            , _hash{std::move(other._hash)}
+        template <typename FunctionType>
+        explicit schedulable_task(FunctionType&& f, std::string&& id, const tc::sdk::cron_schedule& schedule)
+            : _state{std::make_shared<task_state>(std::forward<FunctionType>(f))}
+            , _schedule{schedule}
+            , _id{std::move(id)}
         {
         }
 
-        void invoke()
+        // Recursive task that is not re-scheduled after its runs: each run re-arms the task itself with reschedule() (or removes it).
+        struct rearmed_t
         {
-            _task->invoke();
-        }
+        };
 
-        std::shared_ptr<schedulable_task> clone()
+        template <typename FunctionType>
+        explicit schedulable_task(FunctionType&& f, rearmed_t)
+            : _state{std::make_shared<task_state>(std::forward<FunctionType>(f))}
+            , _is_rearmed{true}
         {
-            return std::shared_ptr<schedulable_task>(new schedulable_task(this));
         }
 
-        void set_enabled(bool is_enabled)
+        ~schedulable_task()
         {
-            _is_enabled = is_enabled;
         }
-        bool is_enabled() const
+
+        schedulable_task(schedulable_task&& other) noexcept
+            : _state{std::move(other._state)}
+            , _interval{std::move(other._interval)}
+            , _schedule{std::move(other._schedule)}
+            , _id{std::move(other._id)}
+            , _is_rearmed{other._is_rearmed}
         {
-            return _is_enabled;
         }
 
-        void set_interval(tc::sdk::clock::duration interval)
+        const std::shared_ptr<task_state>& state() const
         {
-            _interval = interval;
+            return _state;
         }
+
         std::optional<tc::sdk::clock::duration> interval() const
         {
             return _interval;
         }
 
-        std::optional<size_t> hash() const
+        const std::optional<tc::sdk::cron_schedule>& schedule() const
+        {
+            return _schedule;
+        }
+
+        const std::optional<std::string>& id() const
+        {
+            return _id;
+        }
+
+        bool is_rearmed() const
         {
-            return _hash;
+            return _is_rearmed;
         }
 
     private:
-        std::shared_ptr<tc::sdk::task> _task;
-        bool _is_enabled;
+        std::shared_ptr<task_state> _state;
         std::optional<tc::sdk::clock::duration> _interval;
-        std::optional<size_t> _hash;
+        std::optional<tc::sdk::cron_schedule> _schedule;
+        std::optional<std::string> _id;
+        bool _is_rearmed = false;
+    };
+
+    // State of an operation started with retry(), owned by its (re-armed) task.
+    template <typename ResultType, typename Operation, typename Predicate>
+    class retry_context : private non_copyable, private non_moveable
+    {
+    public:
+        retry_context(task_scheduler& scheduler, const retry_policy& policy, Operation&& operation, Predicate&& should_retry)
+            : _scheduler{scheduler}
+            , _policy{policy}
+            , _operation{std::move(operation)}
+            , _should_retry{std::move(should_retry)}
+            , _attempts{0}
+        {
+        }
 
-        schedulable_task(schedulable_task* st)
-            : _task{st->_task}
-            , _is_enabled{st->_is_enabled}
-            , _interval{st->_interval}
-            , _hash{st->_hash}
+        std::future<ResultType> get_future()
         {
+            return _promise.get_future();
+        }
+
+        // Called before the first attempt is armed.
+        void set_handle(task_handle handle)
+        {
+            _handle = handle;
+            if (_policy.deadline.has_value())
+                _deadline = _scheduler._clock->now() + *_policy.deadline;
+        }
+
+        void run_attempt()
+        {
+            ++_attempts;
+            std::exception_ptr error;
+            // The task is removed before the outcome is reported, so that it is no longer scheduled once the future is ready.
+            try
+            {
+                if constexpr (std::is_void_v<ResultType>)
+                {
+                    _operation();
+                    _scheduler.remove_task(_handle);
+                    _promise.set_value();
+                }
+                else
+                {
+                    auto result = _operation();
+                    _scheduler.remove_task(_handle);
+                    _promise.set_value(std::move(result));
+                }
+
+                return;
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            try
+            {
+                const auto next_attempt = _scheduler._clock->now() + _scheduler.retry_delay(_policy, _attempts);
+                const bool is_allowed = (_policy.max_attempts == 0 || _attempts < _policy.max_attempts) && (!_deadline.has_value() || next_attempt <= *_deadline);
+                if (is_allowed && _should_retry(std::as_const(error)) && _scheduler.reschedule(_handle, next_attempt))
+                    return;
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            _scheduler.remove_task(_handle);
+            _promise.set_exception(error);
         }
+
+    private:
+        task_scheduler& _scheduler;
+        const retry_policy _policy;
+        Operation _operation;
+        Predicate _should_retry;
+        std::promise<ResultType> _promise;
+        task_handle _handle;
+        std::optional<tc::sdk::clock::time_point> _deadline;
+        size_t _attempts;
     };
 
 public:
     /*!
      * \brief Constructor
      *
-     * Creates a tc::sdk::task_scheduler instance
+     * Creates a tc::sdk::task_scheduler instance using the timer_backend::ordered_map backend
      */
     explicit task_scheduler();
 
+    /*!
+     * \brief Constructor
+     * \param backend Data structure used to keep track of the scheduled tasks
+     * \param resolution Tick duration of the timer_backend::timing_wheel backend (ignored by timer_backend::ordered_map)
+     *
+     * Creates a tc::sdk::task_scheduler instance using the given backend.
+     * The timer_backend::timing_wheel backend is best suited for a large number of tasks that are frequently
+     * scheduled and removed: in this case tasks start at most one resolution tick after their scheduled time_point.
+     */
+    explicit task_scheduler(timer_backend backend, tc::sdk::clock::duration resolution = std::chrono::milliseconds(1));
+
+    /*!
+     * \brief Constructor
+     * \param clock clock_source used to read the current time and to wait for the tasks start times
+     * \param backend Data structure used to keep track of the scheduled tasks
+     * \param resolution Tick duration of the timer_backend::timing_wheel backend (ignored by timer_backend::ordered_map)
+     *
+     * Creates a tc::sdk::task_scheduler instance driven by the given clock, e.g. a tc::sdk::manual_clock to simulate long
+     * scheduling scenarios without waiting in real time. The time_points passed to tc::sdk::task_scheduler::at
+     * and tc::sdk::task_scheduler::reschedule must be read from the same clock.
+     */
+    explicit task_scheduler(std::shared_ptr<tc::sdk::clock_source> clock, timer_backend backend = timer_backend::ordered_map, tc::sdk::clock::duration resolution = std::chrono::milliseconds(1));
+
+    /*!
+     * \brief Constructor
+     * \param executor External tc::sdk::thread_pool used to run the tasks
+     * \param backend Data structure used to keep track of the scheduled tasks
+     * \param resolution Tick duration of the timer_backend::timing_wheel backend (ignored by timer_backend::ordered_map)
+     *
+     * Creates a tc::sdk::task_scheduler instance that runs its tasks on the given executor instead of an internal thread pool,
+     * so that several components can share the same worker threads.
+     * The executor is neither started nor stopped by the task_scheduler: it must be running while the task_scheduler
+     * is running or being stopped, and it must outlive the task_scheduler.
+     */
+    explicit task_scheduler(tc::sdk::thread_pool& executor, timer_backend backend = timer_backend::ordered_map, tc::sdk::clock::duration resolution = std::chrono::milliseconds(1));
+
+    /*!
+     * \brief Constructor
+     * \param executor External tc::sdk::thread_pool used to run the tasks
+     * \param clock clock_source used to read the current time and to wait for the tasks start times
+     * \param backend Data structure used to keep track of the scheduled tasks
+     * \param resolution Tick duration of the timer_backend::timing_wheel backend (ignored by timer_backend::ordered_map)
+     *
+     * See tc::sdk::task_scheduler::task_scheduler(tc::sdk::thread_pool&, timer_backend, tc::sdk::clock::duration)
+     * and tc::sdk::task_scheduler::task_scheduler(std::shared_ptr<tc::sdk::clock_source>, timer_backend, tc::sdk::clock::duration).
+     */
+    task_scheduler(tc::sdk::thread_pool& executor, std::shared_ptr<tc::sdk::clock_source> clock, timer_backend backend = timer_backend::ordered_map, tc::sdk::clock::duration resolution = std::chrono::milliseconds(1));
+
     /*!
      * \brief Destructor
      *
@@ -155,7 +628,7 @@ public:
 
     /*!
      * \brief Start running tasks
-     * \param num_threads Number of threads that will be used in the underlying tc::sdk::thread_pool
+     * \param num_threads Number of threads that will be used in the underlying tc::sdk::thread_pool (ignored when running on an external executor)
      * \return true if started successfully
      *
      * This function starts the task_scheduler worker thread.
@@ -168,9 +641,64 @@ public:
      * \return true if stopped successfully
      *
      * This function stops the task_scheduler execution and stops all the running tasks.
+     * When running on an external executor, the tasks already dispatched to it are not discarded:
+     * the function returns after they have completed.
      */
     bool stop();
 
+    /*!
+     * \brief Get the clock_source driving the task_scheduler
+     * \return The clock_source the task_scheduler has been created with (tc::sdk::clock_source::steady by default).
+     */
+    const std::shared_ptr<tc::sdk::clock_source>& get_clock() const;
+
+    /*!
+     * \brief Start running tasks without the scheduler thread
+     * \param num_threads Number of threads that will be used in the underlying tc::sdk::thread_pool (ignored when running on an external executor)
+     * \return true if started successfully, false if already running or if the wakeup_backend::timerfd backend is not in use
+     *
+     * The caller drives the scheduler from its own event loop instead: whenever the file descriptor returned by
+     * tc::sdk::task_scheduler::native_handle becomes readable, tc::sdk::task_scheduler::poll must be called.
+     */
+    bool start_polled(const unsigned int num_threads = std::thread::hardware_concurrency());
+
+    /*!
+     * \brief Run the expired tasks of a task_scheduler started with tc::sdk::task_scheduler::start_polled
+     *
+     * Applies the pending requests, dispatches the expired tasks to the thread pool and re-arms the timer for the next start time.
+     * The function never blocks, and it must not be called concurrently from different threads.
+     * \throws std::system_error if the timer cannot be re-armed: the native handle would not become readable at the next start time.
+     */
+    void poll();
+
+    /*!
+     * \brief Select the mechanism used to wait for the next task start time
+     * \param backend wakeup_backend to be used
+     * \return true if the backend has been set, false if the task_scheduler is running or the backend is not available
+     *
+     * The wakeup_backend::timerfd backend is only available on Linux with the default steady clock_source.
+     * It arms absolute deadlines, avoiding the overshoot of std::condition_variable::wait_until on loaded systems,
+     * and exposes a pollable file descriptor (see tc::sdk::task_scheduler::native_handle).
+     * If arming the timer or waiting on it fails, the scheduler thread falls back to wakeup_backend::condition_variable
+     * instead of missing the next start time.
+     */
+    bool set_wakeup_backend(wakeup_backend backend);
+
+    /*!
+     * \brief Get the mechanism used to wait for the next task start time
+     * \return wakeup_backend in use (wakeup_backend::condition_variable by default)
+     */
+    wakeup_backend get_wakeup_backend() const;
+
+    /*!
+     * \brief Get the pollable file descriptor of the wakeup_backend::timerfd backend
+     * \return epoll file descriptor, readable when a task expires or a request is submitted, -1 with the wakeup_backend::condition_variable backend
+     *
+     * The file descriptor is owned by the task_scheduler: it is meant to be registered in an external event loop
+     * (e.g. epoll, poll, select) of a task_scheduler started with tc::sdk::task_scheduler::start_polled.
+     */
+    int native_handle() const;
+
     /*!
      * \brief Get the number of scheduled tasks
      * \return Number of tasks to be run
@@ -191,6 +719,15 @@ public:
      */
     bool is_scheduled(const std::string& task_id);
 
+    /*!
+     * \brief Check if a task is scheduled
+     * \param handle task_handle to check
+     * \return bool indicating if the task is currently scheduled
+     *
+     * In case the handle is expired or invalid this function return false.
+     */
+    bool is_scheduled(task_handle handle);
+
     /*!
      * \brief Check if a task is enabled
      * \param task_id task_id to check
@@ -203,6 +740,15 @@ public:
      */
     bool is_enabled(const std::string& task_id);
 
+    /*!
+     * \brief Check if a task is enabled
+     * \param handle task_handle to check
+     * \return bool indicating if the task is currently enabled
+     *
+     * In case the handle is expired or invalid this function return false.
+     */
+    bool is_enabled(task_handle handle);
+
     /*!
      * \brief Enable or disable task
      * \param task_id task_id to enable or disable
@@ -215,6 +761,16 @@ public:
      */
     bool set_enabled(const std::string& task_id, bool is_enabled);
 
+    /*!
+     * \brief Enable or disable task
+     * \param handle task_handle to enable or disable
+     * \param is_enabled true enables, false disables the given task
+     * \return bool indicating if the task has been properly updated
+     *
+     * In case the handle is expired or invalid this function return false.
+     */
+    bool set_enabled(task_handle handle, bool is_enabled);
+
     /*!
      * \brief Remove a task
      * \param task_id task_id to remove
@@ -226,29 +782,223 @@ public:
      */
     bool remove_task(const std::string& task_id);
 
+    /*!
+     * \brief Remove a task
+     * \param handle task_handle to remove
+     * \return bool indicating if the task has been properly removed
+     *
+     * In case the handle is expired or invalid this function return false.
+     * Once removed, the handle is expired.
+     */
+    bool remove_task(task_handle handle);
+
     /*!
      * \brief Retrieve task interval.
      * \param task_id task_id to retrieve.
      * \return std::optional<sdk::clock::duration> interval associated with given task_id.
      *
-     * If a task is not recursive (i.e. has not been started with every() APIs)
+     * If a task is not recursive (i.e. has not been started with every() APIs), follows a tc::sdk::cron_schedule
      * or the task has not been assigned a task_id, it is not possible to retrieve its interval.
-     * In case of any failure (task_id not found or task non recursive) this function returns std::nullopt.
+     * In case of any failure (task_id not found or task without interval) this function returns std::nullopt.
      */
     std::optional<sdk::clock::duration> get_interval(const std::string& task_id);
 
+    /*!
+     * \brief Retrieve task interval.
+     * \param handle task_handle to retrieve.
+     * \return std::optional<sdk::clock::duration> interval associated with given task.
+     *
+     * In case of any failure (handle expired or task without interval) this function returns std::nullopt.
+     */
+    std::optional<sdk::clock::duration> get_interval(task_handle handle);
+
     /*!
      * \brief Update a task interval
      * \param task_id task_id to update
      * \param interval new task interval to set
      * \return bool indicating if the task has been properly updated
      *
-     * If a task is not recursive (i.e. has not been started with every() APIs)
+     * If a task is not recursive (i.e. has not been started with every() APIs), follows a tc::sdk::cron_schedule
      * or the task has not been assigned a task_id, it is not possible to update it.
-     * In case of any failure (task_id not found or task non recursive) this function return false.
+     * In case of any failure (task_id not found or task without interval) this function return false.
      */
     bool update_interval(const std::string& task_id, interval_t interval);
 
+    /*!
+     * \brief Update a task interval
+     * \param handle task_handle to update
+     * \param interval new task interval to set
+     * \return bool indicating if the task has been properly updated
+     *
+     * In case of any failure (handle expired or task without interval) this function return false.
+     */
+    bool update_interval(task_handle handle, interval_t interval);
+
+    /*!
+     * \brief Move a task to a new start time
+     * \param task_id task_id to reschedule
+     * \param timepoint new start time of the task
+     * \return bool indicating if the task has been properly rescheduled
+     *
+     * Recursive tasks keep running with their interval starting from the new start time,
+     * while tasks following a tc::sdk::cron_schedule resume their schedule after the new start time.
+     * In case a task_id is not found this function return false.
+     */
+    bool reschedule(const std::string& task_id, tc::sdk::clock::time_point timepoint);
+
+    /*!
+     * \brief Move a task to a new start time
+     * \param handle task_handle to reschedule
+     * \param timepoint new start time of the task
+     * \return bool indicating if the task has been properly rescheduled
+     *
+     * Recursive tasks keep running with their interval starting from the new start time.
+     * In case the handle is expired or invalid this function return false.
+     */
+    bool reschedule(task_handle handle, tc::sdk::clock::time_point timepoint);
+
+    /*!
+     * \brief Set the overlap policy of a recursive task
+     * \param task_id task_id to update
+     * \param policy overlap_policy applied from the next run of the task
+     * \return bool indicating if the task has been properly updated
+     *
+     * Recursive tasks use overlap_policy::allow by default: a task slower than its interval may pile up runs in the thread pool.
+     * In case of any failure (task_id not found or task non recursive) this function return false.
+     */
+    bool set_overlap_policy(const std::string& task_id, overlap_policy policy);
+
+    /*!
+     * \brief Set the overlap policy of a recursive task
+     * \param handle task_handle to update
+     * \param policy overlap_policy applied from the next run of the task
+     * \return bool indicating if the task has been properly updated
+     *
+     * In case of any failure (handle expired or task non recursive) this function return false.
+     */
+    bool set_overlap_policy(task_handle handle, overlap_policy policy);
+
+    /*!
+     * \brief Retrieve the overlapping runs counters of a recursive task
+     * \param task_id task_id to retrieve
+     * \return std::optional<overlap_stats> counters of the skipped and coalesced runs of the task
+     *
+     * In case of any failure (task_id not found or task non recursive) this function returns std::nullopt.
+     */
+    std::optional<overlap_stats> get_overlap_stats(const std::string& task_id);
+
+    /*!
+     * \brief Retrieve the overlapping runs counters of a recursive task
+     * \param handle task_handle to retrieve
+     * \return std::optional<overlap_stats> counters of the skipped and coalesced runs of the task
+     *
+     * In case of any failure (handle expired or task non recursive) this function returns std::nullopt.
+     */
+    std::optional<overlap_stats> get_overlap_stats(task_handle handle);
+
+    /*!
+     * \brief Set the default timer slack of the tasks
+     * \param slack maximum delay allowed for the tasks without their own timer slack (zero by default)
+     *
+     * Task start times are rounded up to a multiple of their timer slack, so that the tasks whose start times fall inside
+     * the same slack window are run together with a single wakeup of the scheduler thread.
+     * This lowers the wakeup rate (and the CPU usage) of the scheduler with many recurring tasks, while each task may be run up to slack late.
+     * Recursive tasks keep their nominal interval: the slack does not accumulate over the runs,
+     * but a task with an interval shorter than its slack runs at most once per slack window.
+     * The default timer slack is applied to the tasks the next time they are scheduled.
+     */
+    void set_timer_slack(tc::sdk::clock::duration slack);
+
+    /*!
+     * \brief Get the default timer slack of the tasks
+     * \return The default timer slack set with tc::sdk::task_scheduler::set_timer_slack.
+     */
+    tc::sdk::clock::duration get_timer_slack() const;
+
+    /*!
+     * \brief Set the timer slack of a task
+     * \param task_id task_id to update
+     * \param slack maximum delay allowed for the task, overriding the default timer slack
+     * \return bool indicating if the task has been properly updated
+     *
+     * The pending start time of the task is updated immediately.
+     * In case a task_id is not found this function return false.
+     */
+    bool set_timer_slack(const std::string& task_id, tc::sdk::clock::duration slack);
+
+    /*!
+     * \brief Set the timer slack of a task
+     * \param handle task_handle to update
+     * \param slack maximum delay allowed for the task, overriding the default timer slack
+     * \return bool indicating if the task has been properly updated
+     *
+     * In case the handle is expired or invalid this function return false.
+     */
+    bool set_timer_slack(task_handle handle, tc::sdk::clock::duration slack);
+
+    /*!
+     * \brief Set the phase spreading of the recursive tasks
+     * \param spreading phase_spreading applied to the recursive tasks scheduled from now on
+     *
+     * Recursive tasks with the same interval that are scheduled together (e.g. at startup) are all run in the same tick,
+     * making periodic load spikes on the thread pool. With phase_spreading::jitter or phase_spreading::hash
+     * the first start time of each recursive task is delayed by an offset smaller than its interval, so that the tasks are spread across the interval.
+     * Tasks following a tc::sdk::cron_schedule are not affected.
+     */
+    void set_phase_spreading(phase_spreading spreading);
+
+    /*!
+     * \brief Get the phase spreading of the recursive tasks
+     * \return The phase_spreading set with tc::sdk::task_scheduler::set_phase_spreading.
+     */
+    phase_spreading get_phase_spreading() const;
+
+    /*!
+     * \brief Enable or disable the execution statistics of the tasks
+     * \param is_enabled true enables, false disables the statistics of the tasks scheduled from now on (disabled by default)
+     *
+     * When enabled, each task records in fixed-size histograms how late it is started and how long it runs,
+     * along with the periods it misses: the statistics can be retrieved with tc::sdk::task_scheduler::get_task_stats.
+     * Recording happens on the thread pool workers, without any lock, but requires a fixed-size allocation for each task.
+     */
+    void set_task_stats_enabled(bool is_enabled);
+
+    /*!
+     * \brief Check if the execution statistics of the tasks are enabled
+     * \return bool indicating if the tasks scheduled from now on record their statistics
+     */
+    bool is_task_stats_enabled() const;
+
+    /*!
+     * \brief Retrieve the execution statistics of a task
+     * \param task_id task_id to retrieve
+     * \return std::optional<task_stats> statistics of the task
+     *
+     * Runs merged by overlap_policy::coalesce only record their duration.
+     * In case of any failure (task_id not found or task scheduled without statistics) this function returns std::nullopt.
+     */
+    std::optional<task_stats> get_task_stats(const std::string& task_id);
+
+    /*!
+     * \brief Retrieve the execution statistics of a task
+     * \param handle task_handle to retrieve
+     * \return std::optional<task_stats> statistics of the task
+     *
+     * In case of any failure (handle expired or task scheduled without statistics) this function returns std::nullopt.
+     */
+    std::optional<task_stats> get_task_stats(task_handle handle);
+
+    /*!
+     * \brief Retrieve the dispatch counters of the scheduler thread
+     * \return dispatch_stats collected since the task_scheduler has been created (or since the last reset)
+     */
+    dispatch_stats get_dispatch_stats() const;
+
+    /*!
+     * \brief Reset the dispatch counters of the scheduler thread
+     */
+    void reset_dispatch_stats();
+
     /*!
      * \brief Spawn a task at a given time_point
      *
@@ -256,7 +1006,7 @@ public:
      */
     template <typename TaskFunction>
     auto at(tc::sdk::clock::time_point&& timepoint, TaskFunction&& func)
-        -> std::optional<std::future<std::invoke_result_t<TaskFunction>>>
+        -> std::optional<task_future<std::invoke_result_t<TaskFunction>>>
     {
         auto task = [t = std::forward<TaskFunction>(func)] {
             return t();
@@ -266,10 +1016,11 @@ public:
         auto task_wrapper = std::packaged_task<ReturnType()>(task);
         std::future<ReturnType> future = task_wrapper.get_future();
 
-        if (!add_task(std::move(timepoint), schedulable_task(std::move(task_wrapper))))
+        const auto handle = add_task(std::move(timepoint), schedulable_task(std::move(task_wrapper)));
+        if (!handle)
             return std::nullopt;
 
-        return future;
+        return task_future<ReturnType>(std::move(future), handle);
     }
 
     /*!
@@ -279,7 +1030,7 @@ public:
      */
     template <typename TaskFunction, typename... Args>
     auto at(tc::sdk::clock::time_point&& timepoint, TaskFunction&& func, Args&&... args)
-        -> std::optional<std::future<std::invoke_result_t<TaskFunction, Args...>>>
+        -> std::optional<task_future<std::invoke_result_t<TaskFunction, Args...>>>
     {
         auto task = [t = std::forward<TaskFunction>(func), params = std::make_tuple(std::forward<Args>(args)...)] {
             return std::apply(t, params);
@@ -289,10 +1040,11 @@ public:
         auto task_wrapper = std::packaged_task<ReturnType()>(task);
         std::future<ReturnType> future = task_wrapper.get_future();
 
-        if (!add_task(std::move(timepoint), schedulable_task(std::move(task_wrapper))))
+        const auto handle = add_task(std::move(timepoint), schedulable_task(std::move(task_wrapper)));
+        if (!handle)
             return std::nullopt;
 
-        return future;
+        return task_future<ReturnType>(std::move(future), handle);
     }
 
     /*!
@@ -302,7 +1054,7 @@ public:
      */
     template <typename TaskFunction, typename... Args>
     auto at(std::string&& task_id, tc::sdk::clock::time_point&& timepoint, TaskFunction&& func, Args&&... args)
-        -> std::optional<std::future<std::invoke_result_t<TaskFunction, Args...>>>
+        -> std::optional<task_future<std::invoke_result_t<TaskFunction, Args...>>>
     {
         auto task = [t = std::forward<TaskFunction>(func), params = std::make_tuple(std::forward<Args>(args)...)] {
             return std::apply(t, params);
@@ -312,10 +1064,11 @@ public:
         auto task_wrapper = std::packaged_task<ReturnType()>(task);
         std::future<ReturnType> future = task_wrapper.get_future();
 
-        if (!add_task(std::move(timepoint), schedulable_task(std::move(task_wrapper), _hasher(task_id))))
+        const auto handle = add_task(std::move(timepoint), schedulable_task(std::move(task_wrapper), std::string(task_id)));
+        if (!handle)
             return std::nullopt;
 
-        return future;
+        return task_future<ReturnType>(std::move(future), handle);
     }
 
     /*!
@@ -325,10 +1078,10 @@ public:
      */
     template <typename TaskFunction>
     auto in(delay_t&& delay, TaskFunction&& func)
-        -> std::optional<std::future<std::invoke_result_t<TaskFunction>>>
+        -> std::optional<task_future<std::invoke_result_t<TaskFunction>>>
     {
         return at(
-            std::forward<tc::sdk::clock::time_point>(tc::sdk::clock::now() + delay),
+            std::forward<tc::sdk::clock::time_point>(_clock->now() + delay),
             std::forward<TaskFunction>(func));
     }
 
@@ -339,10 +1092,10 @@ public:
      */
     template <typename TaskFunction, typename... Args>
     auto in(delay_t&& delay, TaskFunction&& func, Args&&... args)
-        -> std::optional<std::future<std::invoke_result_t<TaskFunction, Args...>>>
+        -> std::optional<task_future<std::invoke_result_t<TaskFunction, Args...>>>
     {
         return at(
-            std::forward<tc::sdk::clock::time_point>(tc::sdk::clock::now() + delay),
+            std::forward<tc::sdk::clock::time_point>(_clock->now() + delay),
             std::forward<TaskFunction>(func),
             std::forward<Args>(args)...);
     }
@@ -354,11 +1107,11 @@ public:
      */
     template <typename TaskFunction, typename... Args>
     auto in(std::string&& task_id, delay_t&& delay, TaskFunction&& func, Args&&... args)
-        -> std::optional<std::future<std::invoke_result_t<TaskFunction, Args...>>>
+        -> std::optional<task_future<std::invoke_result_t<TaskFunction, Args...>>>
     {
         return at(
             std::forward<std::string>(task_id),
-            std::forward<tc::sdk::clock::time_point>(tc::sdk::clock::now() + delay),
+            std::forward<tc::sdk::clock::time_point>(_clock->now() + delay),
             std::forward<TaskFunction>(func),
             std::forward<Args>(args)...);
     }
@@ -369,13 +1122,13 @@ public:
      * TODO
      */
     template <typename TaskFunction>
-    auto every(interval_t&& interval, TaskFunction&& func) -> bool
+    auto every(interval_t&& interval, TaskFunction&& func) -> task_handle
     {
         auto task = [t = std::forward<TaskFunction>(func)] {
             return t();
         };
 
-        return add_task(tc::sdk::clock::now(), schedulable_task(std::move(task), interval));
+        return add_task(_clock->now(), schedulable_task(std::move(task), interval));
     }
 
     /*!
@@ -384,13 +1137,13 @@ public:
      * TODO
      */
     template <typename TaskFunction, typename... Args>
-    auto every(interval_t&& interval, TaskFunction&& func, Args&&... args) -> bool
+    auto every(interval_t&& interval, TaskFunction&& func, Args&&... args) -> task_handle
     {
         auto task = [t = std::forward<TaskFunction>(func), params = std::make_tuple(std::forward<Args>(args)...)] {
             return std::apply(t, params);
         };
 
-        return add_task(tc::sdk::clock::now(), schedulable_task(std::move(task), interval));
+        return add_task(_clock->now(), schedulable_task(std::move(task), interval));
     }
 
     /*!
@@ -399,13 +1152,13 @@ public:
      * TODO
      */
     template <typename TaskFunction, typename... Args>
-    auto every(std::string&& task_id, interval_t&& interval, TaskFunction&& func, Args&&... args) -> bool
+    auto every(std::string&& task_id, interval_t&& interval, TaskFunction&& func, Args&&... args) -> task_handle
     {
         auto task = [t = std::forward<TaskFunction>(func), params = std::make_tuple(std::forward<Args>(args)...)] {
             return std::apply(t, params);
         };
 
-        return add_task(tc::sdk::clock::now(), schedulable_task(std::move(task), _hasher(task_id), interval));
+        return add_task(_clock->now(), schedulable_task(std::move(task), std::string(task_id), interval));
     }
 
     /*!
@@ -414,28 +1167,426 @@ public:
      * TODO
      */
     template <typename TaskFunction, typename... Args>
-    auto every(std::string&& task_id, interval_t&& interval, delay_t&& delay, TaskFunction&& func, Args&&... args) -> bool
+    auto every(std::string&& task_id, interval_t&& interval, delay_t&& delay, TaskFunction&& func, Args&&... args) -> task_handle
+    {
+        auto task = [t = std::forward<TaskFunction>(func), params = std::make_tuple(std::forward<Args>(args)...)] {
+            return std::apply(t, params);
+        };
+
+        return add_task(_clock->now() + delay, schedulable_task(std::move(task), std::string(task_id), interval));
+    }
+
+    /*!
+     * \brief Spawn a task following a calendar based schedule
+     * \param schedule tc::sdk::cron_schedule evaluated against the UTC system time
+     * \return task_handle of the scheduled task, invalid if the schedule never matches after the current time
+     *
+     * After each run, the next start time is computed from the schedule and converted to a tc::sdk::clock time_point:
+     * the task keeps following the calendar even if the system clock is adjusted in the meantime.
+     * Runs whose time has already passed (e.g. while the task was disabled) are not recovered.
+     */
+    template <typename TaskFunction, typename... Args>
+    auto every(const tc::sdk::cron_schedule& schedule, TaskFunction&& func, Args&&... args) -> task_handle
+    {
+        auto task = [t = std::forward<TaskFunction>(func), params = std::make_tuple(std::forward<Args>(args)...)] {
+            return std::apply(t, params);
+        };
+
+        return add_task(_clock->now(), schedulable_task(std::move(task), schedule));
+    }
+
+    /*!
+     * \brief Spawn a task following a calendar based schedule
+     * \param task_id task_id of the task
+     * \param schedule tc::sdk::cron_schedule evaluated against the UTC system time
+     * \return task_handle of the scheduled task, invalid if the schedule never matches after the current time
+     *
+     * See tc::sdk::task_scheduler::every(const tc::sdk::cron_schedule&, TaskFunction&&, Args&&...).
+     */
+    template <typename TaskFunction, typename... Args>
+    auto every(std::string&& task_id, const tc::sdk::cron_schedule& schedule, TaskFunction&& func, Args&&... args) -> task_handle
     {
         auto task = [t = std::forward<TaskFunction>(func), params = std::make_tuple(std::forward<Args>(args)...)] {
             return std::apply(t, params);
         };
 
-        return add_task(tc::sdk::clock::now() + delay, schedulable_task(std::move(task), _hasher(task_id), interval));
+        return add_task(_clock->now(), schedulable_task(std::move(task), std::string(task_id), schedule));
+    }
+
+    /*!
+     * \brief Spawn a task that runs only when it is armed
+     * \param func Task function
+     * \return task_handle of the task, invalid if the task_scheduler is not running
+     *
+     * The task is not scheduled until tc::sdk::task_scheduler::reschedule is called with its handle,
+     * and after each run it is parked again until the next reschedule() call.
+     * Arming the task again before it runs simply moves its start time: re-arming is O(1) and never allocates,
+     * which makes on-demand tasks the building block of timers that are restarted very often (see tc::sdk::debouncer and tc::sdk::throttler).
+     * The task is removed with tc::sdk::task_scheduler::remove_task.
+     */
+    template <typename TaskFunction>
+    auto on_demand(TaskFunction&& func) -> task_handle
+    {
+        auto task = [t = std::forward<TaskFunction>(func)] {
+            return t();
+        };
+
+        return add_task(_clock->now(), schedulable_task(std::move(task), schedulable_task::rearmed_t{}));
+    }
+
+    /*!
+     * \brief Run an operation, retrying it with a backoff while it throws
+     * \param policy Maximum number of attempts, backoff delays and overall deadline
+     * \param operation Callable object run by each attempt: an attempt fails if it throws an exception
+     * \return task_future holding the result of the first successful attempt, or the exception of the last failed attempt,
+     * std::nullopt if the task_scheduler is not running
+     *
+     * The first attempt is run as soon as possible.
+     * All the attempts are run by the same task slot, which is re-armed in place after each failure:
+     * no allocation and no std::future is created for each attempt.
+     * Removing the task through tc::sdk::task_scheduler::task_future::handle cancels the next attempts:
+     * the future then reports the outcome of the attempt in progress, if any, otherwise a std::future_errc::broken_promise error.
+     */
+    template <typename Operation>
+    auto retry(const retry_policy& policy, Operation&& operation)
+        -> std::optional<task_future<std::invoke_result_t<Operation>>>
+    {
+        return retry(policy, std::forward<Operation>(operation), [](const std::exception_ptr&) { return true; });
+    }
+
+    /*!
+     * \brief Run an operation, retrying it with a backoff while it throws retriable errors
+     * \param policy Maximum number of attempts, backoff delays and overall deadline
+     * \param operation Callable object run by each attempt: an attempt fails if it throws an exception
+     * \param should_retry Predicate invoked with the std::exception_ptr of each failed attempt: the operation is retried only if it returns true
+     * \return task_future holding the result of the first successful attempt, or the exception of the last failed attempt,
+     * std::nullopt if the task_scheduler is not running
+     *
+     * See tc::sdk::task_scheduler::retry(const retry_policy&, Operation&&).
+     */
+    template <typename Operation, typename Predicate>
+    auto retry(const retry_policy& policy, Operation&& operation, Predicate&& should_retry)
+        -> std::optional<task_future<std::invoke_result_t<Operation>>>
+    {
+        using ReturnType = std::invoke_result_t<Operation>;
+        using ContextType = retry_context<ReturnType, std::decay_t<Operation>, std::decay_t<Predicate>>;
+
+        auto context = std::make_shared<ContextType>(*this, policy, std::decay_t<Operation>(std::forward<Operation>(operation)), std::decay_t<Predicate>(std::forward<Predicate>(should_retry)));
+        auto future = context->get_future();
+
+        // The task is parked until the handle is known by the context: then the first attempt is armed.
+        const auto handle = add_task(_clock->now(), schedulable_task([context] { context->run_attempt(); }, schedulable_task::rearmed_t{}));
+        if (!handle)
+            return std::nullopt;
+
+        context->set_handle(handle);
+        reschedule(handle, _clock->now());
+        return task_future<ReturnType>(std::move(future), handle);
+    }
+
+    /*!
+     * \class sleep_awaitable
+     * \brief Awaitable returned by tc::sdk::task_scheduler::sleep_for and tc::sdk::task_scheduler::sleep_until.
+     *
+     * The suspended coroutine is registered as a one-shot task in the timer structure of the scheduler, without blocking any thread:
+     * it is resumed on a thread of the scheduler thread pool once the time_point is reached.
+     * co_await returns true if the time_point has been reached, false if the sleep has been cancelled:
+     * if the task_scheduler is not running the coroutine is not suspended at all, and the coroutines suspended
+     * when the task_scheduler is stopped are resumed by tc::sdk::task_scheduler::stop, on the stopping thread.
+     */
+    class sleep_awaitable
+    {
+    public:
+        bool await_ready()
+        {
+            _is_cancelled = !_scheduler._is_running;
+            return _is_cancelled || _timepoint <= _scheduler._clock->now();
+        }
+
+        void await_suspend(std::coroutine_handle<> coroutine)
+        {
+            // If the task is discarded (e.g. the scheduler is stopped before the time_point, or even before add_task returns)
+            // the resumer resumes the coroutine as cancelled: this awaitable must not be accessed once the task is submitted.
+            _scheduler.add_task(tc::sdk::clock::time_point(_timepoint), schedulable_task(detail::coroutine_resumer(coroutine, _is_cancelled)));
+        }
+
+        bool await_resume() const noexcept
+        {
+            return !_is_cancelled;
+        }
+
+    private:
+        friend class task_scheduler;
+
+        sleep_awaitable(task_scheduler& scheduler, tc::sdk::clock::time_point timepoint)
+            : _scheduler{scheduler}
+            , _timepoint{timepoint}
+        {
+        }
+
+        task_scheduler& _scheduler;
+        const tc::sdk::clock::time_point _timepoint;
+        bool _is_cancelled = false;
+    };
+
+    /*!
+     * \class timeout_awaitable
+     * \brief Awaitable returned by tc::sdk::task_scheduler::with_timeout.
+     * \tparam Awaitable Type of the awaited operation
+     *
+     * co_await returns a std::optional holding the result of the operation, or std::nullopt if the timeout expires first
+     * (a bool for operations returning void, false if the timeout expires first).
+     * The timeout is cancelled, with the same result as an expired one, when the task_scheduler is stopped before the operation completes
+     * (the waiting coroutine is then resumed by tc::sdk::task_scheduler::stop, on the stopping thread),
+     * and when the task_scheduler is not running: the operation is then not even started.
+     * Exceptions thrown by the operation are rethrown to the awaiting coroutine.
+     */
+    template <typename Awaitable>
+    class timeout_awaitable
+    {
+        using operation_result_type = detail::await_result_t<Awaitable>;
+
+    public:
+        using result_type = std::conditional_t<std::is_void_v<operation_result_type>, bool, std::optional<std::remove_cvref_t<operation_result_type>>>;
+
+        bool await_ready() const noexcept
+        {
+            return !_scheduler._is_running;
+        }
+
+        void await_suspend(std::coroutine_handle<> coroutine)
+        {
+            // Once the timer is armed, the coroutine (and this awaitable with it) can be resumed and destroyed at any time:
+            // the members are moved to locals beforehand.
+            auto& scheduler = _scheduler;
+            auto operation = std::move(_operation);
+            auto state = _state;
+            state->waiter = coroutine;
+
+            // If the scheduler has just been stopped, the discarded timer has already resumed the coroutine as timed out.
+            const auto timer = scheduler.add_task(scheduler._clock->now() + _timeout, schedulable_task(timeout_timer(state)));
+            if (!timer)
+                return;
+
+            state->timer = timer;
+            run_operation(scheduler, std::move(state), std::move(operation));
+        }
+
+        result_type await_resume()
+        {
+            if (_state->exception)
+                std::rethrow_exception(_state->exception);
+
+            return std::move(_state->result);
+        }
+
+    private:
+        friend class task_scheduler;
+
+        // Only the first between the operation and the timer to complete writes the result and resumes the waiting coroutine.
+        struct timeout_state
+        {
+            std::atomic<bool> is_completed{false};
+            std::coroutine_handle<> waiter;
+            task_handle timer;
+            result_type result{};
+            std::exception_ptr exception;
+        };
+
+        // Expires the timeout when it is called, or when it is destroyed without having been called (the timer task has been discarded by stop()).
+        class timeout_timer
+        {
+        public:
+            explicit timeout_timer(std::shared_ptr<timeout_state> state) noexcept
+                : _state{std::move(state)}
+            {
+            }
+
+            timeout_timer(timeout_timer&& other) noexcept = default;
+            timeout_timer& operator=(timeout_timer&&) = delete;
+
+            ~timeout_timer()
+            {
+                expire();
+            }
+
+            void operator()()
+            {
+                expire();
+            }
+
+        private:
+            void expire()
+            {
+                if (const auto state = std::exchange(_state, nullptr); state && !state->is_completed.exchange(true))
+                    state->waiter.resume();
+            }
+
+            std::shared_ptr<timeout_state> _state;
+        };
+
+        timeout_awaitable(task_scheduler& scheduler, Awaitable&& operation, tc::sdk::clock::duration timeout)
+            : _scheduler{scheduler}
+            , _operation{std::move(operation)}
+            , _timeout{timeout}
+            , _state{std::make_shared<timeout_state>()}
+        {
+        }
+
+        static detail::detached_coroutine run_operation(task_scheduler& scheduler, std::shared_ptr<timeout_state> state, Awaitable operation)
+        {
+            try
+            {
+                if constexpr (std::is_void_v<operation_result_type>)
+                {
+                    co_await std::move(operation);
+                    if (state->is_completed.exchange(true))
+                        co_return;
+
+                    state->result = true;
+                }
+                else
+                {
+                    auto result = co_await std::move(operation);
+                    if (state->is_completed.exchange(true))
+                        co_return;
+
+                    state->result.emplace(std::move(result));
+                }
+            }
+            catch (...)
+            {
+                if (state->is_completed.exchange(true))
+                    co_return;
+
+                state->exception = std::current_exception();
+            }
+
+            scheduler.remove_task(state->timer);
+            state->waiter.resume();
+        }
+
+        task_scheduler& _scheduler;
+        Awaitable _operation;
+        const tc::sdk::clock::duration _timeout;
+        std::shared_ptr<timeout_state> _state;
+    };
+
+    /*!
+     * \brief Suspend the calling coroutine for the given duration
+     * \param duration Time to wait before resuming the coroutine
+     * \return sleep_awaitable to be awaited with co_await
+     *
+     * See tc::sdk::task_scheduler::sleep_awaitable.
+     */
+    auto sleep_for(tc::sdk::clock::duration duration) -> sleep_awaitable
+    {
+        return sleep_awaitable(*this, _clock->now() + duration);
+    }
+
+    /*!
+     * \brief Suspend the calling coroutine until the given time_point
+     * \param timepoint Time at which the coroutine is resumed, read from the clock_source of the scheduler
+     * \return sleep_awaitable to be awaited with co_await
+     *
+     * See tc::sdk::task_scheduler::sleep_awaitable.
+     */
+    auto sleep_until(tc::sdk::clock::time_point timepoint) -> sleep_awaitable
+    {
+        return sleep_awaitable(*this, timepoint);
+    }
+
+    /*!
+     * \brief Await an operation for at most the given timeout
+     * \param operation Awaitable object (with member await_ready/await_suspend/await_resume functions, or a member operator co_await)
+     * \param timeout Maximum time to wait for the operation to complete
+     * \return timeout_awaitable to be awaited with co_await
+     *
+     * The operation is started when the timeout_awaitable is awaited, and it is not cancelled when the timeout expires:
+     * it keeps running in the background and its result is discarded.
+     * See tc::sdk::task_scheduler::timeout_awaitable.
+     */
+    template <typename Awaitable>
+    auto with_timeout(Awaitable&& operation, tc::sdk::clock::duration timeout) -> timeout_awaitable<std::remove_cvref_t<Awaitable>>
+    {
+        return timeout_awaitable<std::remove_cvref_t<Awaitable>>(*this, std::remove_cvref_t<Awaitable>(std::forward<Awaitable>(operation)), timeout);
     }
 
 private:
-    tc::sdk::thread_pool _tp;
+    using slot_index_t = uint32_t;
+    struct task_slot;
+
+    task_scheduler(std::shared_ptr<tc::sdk::clock_source> clock, timer_backend backend, tc::sdk::clock::duration resolution, tc::sdk::thread_pool* executor);
+
+    std::shared_ptr<tc::sdk::clock_source> _clock;
+    std::optional<tc::sdk::thread_pool> _owned_tp; // Empty when running on an external executor.
+    tc::sdk::thread_pool& _tp;
+    std::atomic<bool> _is_running;
+    std::atomic<size_t> _dispatched_tasks_count; // Tasks queued or running in _tp.
+    std::atomic<size_t> _active_producers;       // Calls writing task slots or submitting them: stop() waits for them before clearing the tasks.
     std::thread _scheduler_thread;
-    std::multimap<tc::sdk::clock::time_point, schedulable_task> _tasks;
-    std::condition_variable _update_tasks_cv;
-    std::mutex _update_tasks_mtx;
-    std::hash<std::string> _hasher;
-    std::atomic<tc::sdk::clock::time_point> _next_task_timepoint;
 
-    bool add_task(tc::sdk::clock::time_point&& timepoint, schedulable_task&& st);
+    // Task slots never move once allocated and are recycled through a lock-free free list: producers can allocate them without locking.
+    std::unique_ptr<detail::slot_pool<task_slot>> _slots;
+    std::atomic<size_t> _tasks_count;
+    std::atomic<tc::sdk::clock::rep> _timer_slack;
+    std::atomic<phase_spreading> _phase_spreading;
+    std::atomic<bool> _is_task_stats_enabled;
+
+    // Written by the scheduler thread only.
+    struct dispatch_counters
+    {
+        std::atomic<uint64_t> wakeups{0};
+        std::atomic<uint64_t> ticks{0};
+        std::atomic<uint64_t> dispatched_tasks{0};
+        std::atomic<uint64_t> max_tasks_per_tick{0};
+        std::array<std::atomic<uint64_t>, dispatch_stats::histogram_size> tasks_per_tick{};
+    };
+    dispatch_counters _dispatch_counters;
+
+    // Lock-free MPSC stack of the slots with pending requests, drained by the scheduler thread.
+    std::atomic<slot_index_t> _submitted_slots_head;
+
+    // Owned by the scheduler thread.
+    std::unique_ptr<detail::timer_queue> _timers;
+    std::vector<slot_index_t> _submitted_slots;
+    std::vector<slot_index_t> _expired_slots;
+
+    std::unordered_map<std::string, task_handle> _task_ids;
+    std::mutex _task_ids_mtx;
+
+    std::condition_variable _wakeup_cv;
+    std::mutex _wakeup_mtx;
+    std::atomic<bool> _is_sleeping;
+    std::unique_ptr<detail::timerfd_waiter> _timerfd_waiter; // Set with the wakeup_backend::timerfd backend.
+    std::atomic<bool> _is_timerfd_failed;                    // The scheduler thread fell back to the condition variable.
+    std::atomic<bool> _is_polled;
+
+    task_handle add_task(tc::sdk::clock::time_point&& timepoint, schedulable_task&& st);
+    std::optional<task_handle> get_task_handle(const std::string& task_id);
+    task_slot* get_task_slot(task_handle handle) const;
+    task_slot& slot(slot_index_t index) const;
+    void release_slot(slot_index_t index);
+    template <typename WriteFunction>
+    bool submit_request(task_handle handle, uint64_t request, WriteFunction&& write);
+    void submit(slot_index_t index);
+    void wake_up();
+    bool is_timerfd_active() const;
+    void wait_for_work();
+    void arm_timerfd();
+    void drain_submissions();
     void update_tasks();
-    auto get_task_iterator(const std::string& task_id) -> decltype(_tasks)::iterator;
-    bool already_exists(const std::optional<size_t>& opt_hash);
+    std::optional<tc::sdk::clock::time_point> next_start_time(task_slot& task_slot, tc::sdk::clock::time_point now) const;
+    tc::sdk::clock::duration phase_offset(const schedulable_task& st, slot_index_t index, tc::sdk::clock::duration interval) const;
+    tc::sdk::clock::duration retry_delay(const retry_policy& policy, size_t attempt) const;
+    bool run_recursive_task(task_slot& task_slot);
+    void record_tick(uint64_t dispatched_tasks);
+    void run_task(task_state& state, std::optional<tc::sdk::clock::time_point> timepoint) const;
+    void run_exclusive(task_state& state, tc::sdk::clock::time_point timepoint) const;
+    void reschedule_slot(slot_index_t index, tc::sdk::clock::time_point timepoint);
+    void insert_timer(slot_index_t index);
+    tc::sdk::clock::time_point expiry_time(const task_slot& task_slot) const;
+    void clear_tasks();
 };
 
 }
@@ -16,6 +16,7 @@
 
 #include <teiacare/sdk/non_copyable.hpp>
 #include <teiacare/sdk/non_moveable.hpp>
+#include <teiacare/sdk/queue_stats.hpp>
 #include <teiacare/sdk/task.hpp>
 
 #include <atomic>
@@ -24,7 +25,7 @@
 #include <future>
 #include <latch>
 #include <mutex>
-#include <queue>
+#include <optional>
 #include <thread>
 #include <vector>
 
@@ -86,6 +87,16 @@ public:
      */
     bool is_running() const;
 
+    /*!
+     * \brief Get a snapshot of the internal task queue counters.
+     * \return tc::sdk::queue_stats snapshot
+     *
+     * The task queue is unbounded, so producers are never blocked, while tc::sdk::queue_stats::pop_blocked_time reports the time spent by idle workers.
+     * Counters are only available when the project is configured with TC_ENABLE_QUEUE_STATS (see tc::sdk::queue_stats_enabled),
+     * otherwise a zero initialized snapshot is returned.
+     */
+    queue_stats stats() const;
+
     /*!
      * \brief Run a callable object asynchronously.
      * \tparam Callable Type of the callable object.
@@ -109,17 +120,37 @@ public:
         return future;
     }
 
+    /*!
+     * \brief Run a callable object asynchronously, discarding its result.
+     * \tparam Callable Type of the callable object.
+     * \param f Callable object.
+     *
+     * Enqueue a new task with the given callable object.
+     * The enqueued task will run as soon as a thread is available.
+     * Unlike tc::sdk::thread_pool::run, no std::future is created:
+     * callable objects that fit in the tc::sdk::task inline storage are enqueued without any heap allocation.
+     */
+    template <typename Callable>
+    void execute(Callable&& f)
+    {
+        enqueue_task(tc::sdk::task(std::forward<Callable>(f)));
+    }
+
 protected:
     void worker();
     void enqueue_task(tc::sdk::task&& task);
+    tc::sdk::task dequeue_task();
 
 private:
     std::atomic_bool _is_running;
     std::mutex _is_running_mutex;
     std::vector<std::thread> _threads;
-    std::queue<tc::sdk::task> _task_queue;
+    std::vector<std::optional<tc::sdk::task>> _task_queue; // Circular buffer: grows when full, never shrinks.
+    size_t _task_queue_head;
+    size_t _task_queue_size;
     std::condition_variable _task_cv;
-    std::mutex _task_mutex;
+    mutable std::mutex _task_mutex;
+    detail::queue_stats_recorder _task_stats;
     std::shared_ptr<std::latch> is_ready;
 };
 
@@ -0,0 +1,88 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <teiacare/sdk/clock.hpp>
+#include <teiacare/sdk/non_copyable.hpp>
+#include <teiacare/sdk/non_moveable.hpp>
+#include <teiacare/sdk/task_scheduler.hpp>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace tc::sdk
+{
+/*!
+ * \class throttler
+ * \brief Run a callback at most once per period, however many events are triggered.
+ *
+ * The first event runs the callback as soon as possible, then the events triggered within the following period
+ * are coalesced in a single call at the end of the period (leading and trailing edge throttling): the last event of a burst is never lost.
+ * The callback runs on the tc::sdk::task_scheduler thread pool.
+ * The throttler is backed by a single tc::sdk::task_scheduler::on_demand task: re-arming it is O(1) and never allocates,
+ * while the events triggered when a call is already pending only cost an atomic exchange.
+ */
+class throttler : private non_copyable, private non_moveable
+{
+public:
+    /*!
+     * \brief Constructor
+     * \param scheduler Running tc::sdk::task_scheduler used to run the callback
+     * \param period Minimum time between the start of two consecutive calls
+     * \param callback Callback function
+     *
+     * Creates a tc::sdk::throttler instance. The scheduler must be running and it must outlive the throttler.
+     */
+    throttler(tc::sdk::task_scheduler& scheduler, tc::sdk::clock::duration period, std::function<void()> callback);
+
+    /*!
+     * \brief Destructor
+     *
+     * Cancels the pending call, if any, and waits for the running callback to complete.
+     * The destructor must not be called from the callback itself.
+     */
+    ~throttler();
+
+    /*!
+     * \brief Notify a new event
+     * \return true if the callback has been armed (or was already pending), false if the throttler is not bound to a running scheduler
+     */
+    bool trigger();
+
+    /*!
+     * \brief Check if a call is pending
+     * \return true if the callback will be run, at the latest once the current period is over
+     */
+    bool is_pending() const;
+
+private:
+    // Shared with the scheduler task, which can outlive the throttler while it is queued in the thread pool.
+    struct state
+    {
+        std::function<void()> callback;
+        std::atomic<tc::sdk::clock::rep> next_run_time{0}; // Earliest start time of the next call.
+        std::atomic<bool> is_pending{false};
+        std::atomic<bool> is_cancelled{false};
+        std::atomic<size_t> running_count{0};
+    };
+
+    tc::sdk::task_scheduler& _scheduler;
+    const tc::sdk::clock::duration _period;
+    std::shared_ptr<state> _state;
+    tc::sdk::task_scheduler::task_handle _handle;
+};
+
+}
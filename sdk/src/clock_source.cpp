@@ -0,0 +1,186 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <teiacare/sdk/clock_source.hpp>
+
+#include <algorithm>
+#include <thread>
+
+namespace tc::sdk
+{
+void clock_source::subscribe(std::condition_variable&, std::mutex&)
+{
+}
+
+void clock_source::unsubscribe(std::condition_variable&)
+{
+}
+
+std::shared_ptr<clock_source> clock_source::steady()
+{
+    static const std::shared_ptr<clock_source> steady_clock = std::make_shared<steady_clock_source>();
+    return steady_clock;
+}
+
+tc::sdk::clock::time_point steady_clock_source::now() const
+{
+    return tc::sdk::clock::now();
+}
+
+tc::sdk::sys_time_point steady_clock_source::system_now() const
+{
+    return std::chrono::time_point_cast<tc::sdk::sys_time_point::duration>(std::chrono::system_clock::now());
+}
+
+void steady_clock_source::wait_until(std::condition_variable& cv, std::unique_lock<std::mutex>& lock, tc::sdk::clock::time_point timepoint)
+{
+    cv.wait_until(lock, timepoint);
+}
+
+void steady_clock_source::wait(std::condition_variable& cv, std::unique_lock<std::mutex>& lock)
+{
+    cv.wait(lock);
+}
+
+void steady_clock_source::sleep_until(tc::sdk::clock::time_point timepoint)
+{
+    std::this_thread::sleep_until(timepoint);
+}
+
+manual_clock::manual_clock(tc::sdk::clock::time_point start, tc::sdk::sys_time_point system_start)
+    : _start{start}
+    , _system_start{system_start}
+    , _now{start.time_since_epoch().count()}
+    , _blocked_threads_count{0}
+    , _epoch{0}
+{
+}
+
+tc::sdk::clock::time_point manual_clock::now() const
+{
+    return tc::sdk::clock::time_point{tc::sdk::clock::duration{_now.load()}};
+}
+
+tc::sdk::sys_time_point manual_clock::system_now() const
+{
+    return _system_start + (now() - _start);
+}
+
+void manual_clock::wait_until(std::condition_variable& cv, std::unique_lock<std::mutex>& lock, tc::sdk::clock::time_point timepoint)
+{
+    block_on(cv, lock, timepoint);
+}
+
+void manual_clock::wait(std::condition_variable& cv, std::unique_lock<std::mutex>& lock)
+{
+    block_on(cv, lock, std::nullopt);
+}
+
+void manual_clock::sleep_until(tc::sdk::clock::time_point timepoint)
+{
+    std::unique_lock lock(_sleep_mtx);
+    while (now() < timepoint)
+        block_on(_sleep_cv, lock, timepoint);
+}
+
+void manual_clock::subscribe(std::condition_variable& cv, std::mutex& mtx)
+{
+    std::scoped_lock lock(_subscribers_mtx);
+    _subscribers.emplace_back(&cv, &mtx);
+}
+
+void manual_clock::unsubscribe(std::condition_variable& cv)
+{
+    std::scoped_lock lock(_subscribers_mtx);
+    std::erase_if(_subscribers, [&cv](auto&& subscriber) { return subscriber.first == &cv; });
+}
+
+void manual_clock::advance(tc::sdk::clock::duration duration)
+{
+    if (duration <= tc::sdk::clock::duration{0})
+        return;
+
+    {
+        std::scoped_lock lock(_state_mtx);
+        _now.fetch_add(duration.count());
+        _blocked_threads_count = 0;
+        ++_epoch;
+    }
+
+    notify_subscribers();
+}
+
+void manual_clock::advance_to(tc::sdk::clock::time_point timepoint)
+{
+    {
+        std::scoped_lock lock(_state_mtx);
+        if (timepoint <= now())
+            return;
+
+        _now.store(timepoint.time_since_epoch().count());
+        _blocked_threads_count = 0;
+        ++_epoch;
+    }
+
+    notify_subscribers();
+}
+
+void manual_clock::wait_for_idle(size_t threads_count)
+{
+    std::unique_lock lock(_state_mtx);
+    _state_cv.wait(lock, [this, threads_count] { return _blocked_threads_count >= threads_count; });
+}
+
+void manual_clock::block_on(std::condition_variable& cv, std::unique_lock<std::mutex>& lock, std::optional<tc::sdk::clock::time_point> timepoint)
+{
+    // The time is checked while holding the caller lock, and subscribers are notified while holding the same lock:
+    // a change of time cannot be missed between the check and the wait.
+    uint64_t epoch = 0;
+    {
+        std::scoped_lock state_lock(_state_mtx);
+        if (timepoint.has_value() && now() >= *timepoint)
+            return;
+
+        epoch = _epoch;
+        ++_blocked_threads_count;
+    }
+    _state_cv.notify_all();
+
+    cv.wait(lock);
+
+    // Woken up by the owner of the condition variable rather than by a change of time: the thread is no longer idle.
+    std::scoped_lock state_lock(_state_mtx);
+    if (_epoch == epoch)
+        --_blocked_threads_count;
+}
+
+void manual_clock::notify_subscribers()
+{
+    {
+        std::scoped_lock lock(_subscribers_mtx);
+        for (auto&& [cv, mtx] : _subscribers)
+        {
+            {
+                std::scoped_lock subscriber_lock(*mtx);
+            }
+            cv->notify_all();
+        }
+    }
+
+    {
+        std::scoped_lock lock(_sleep_mtx);
+    }
+    _sleep_cv.notify_all();
+}
+
+}
@@ -0,0 +1,359 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <teiacare/sdk/datetime/cron_schedule.hpp>
+
+#include <array>
+#include <bit>
+#include <cctype>
+#include <charconv>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace tc::sdk
+{
+namespace
+{
+constexpr std::array<std::string_view, 12> month_names = {"JAN", "FEB", "MAR", "APR", "MAY", "JUN", "JUL", "AUG", "SEP", "OCT", "NOV", "DEC"};
+constexpr std::array<std::string_view, 7> weekday_names = {"SUN", "MON", "TUE", "WED", "THU", "FRI", "SAT"};
+constexpr uint8_t all_days_of_week = 0x7F;
+
+// A schedule that does not match any day in a whole 400 years Gregorian cycle never matches.
+constexpr int max_search_years = 400;
+
+struct macro
+{
+    std::string_view name;
+    std::string_view expression;
+};
+
+constexpr std::array<macro, 7> macros = {{
+    {"@yearly", "0 0 1 1 *"},
+    {"@annually", "0 0 1 1 *"},
+    {"@monthly", "0 0 1 * *"},
+    {"@weekly", "0 0 * * 0"},
+    {"@daily", "0 0 * * *"},
+    {"@midnight", "0 0 * * *"},
+    {"@hourly", "0 * * * *"},
+}};
+
+[[noreturn]] void throw_invalid(const std::string& expression, const std::string& reason)
+{
+    throw std::runtime_error("Invalid cron expression \"" + expression + "\": " + reason);
+}
+
+bool equals_ignore_case(std::string_view lhs, std::string_view rhs)
+{
+    if (lhs.size() != rhs.size())
+        return false;
+
+    for (size_t i = 0; i < lhs.size(); ++i)
+        if (std::toupper(static_cast<unsigned char>(lhs[i])) != std::toupper(static_cast<unsigned char>(rhs[i])))
+            return false;
+
+    return true;
+}
+
+std::optional<unsigned> parse_number(std::string_view token)
+{
+    unsigned value = 0;
+    const auto [end, error] = std::from_chars(token.data(), token.data() + token.size(), value);
+    if (token.empty() || error != std::errc{} || end != token.data() + token.size())
+        return std::nullopt;
+
+    return value;
+}
+
+template <size_t N>
+std::optional<unsigned> parse_value(std::string_view token, unsigned min, unsigned max, const std::array<std::string_view, N>* names, unsigned first_name_value)
+{
+    auto value = parse_number(token);
+
+    if (!value.has_value() && names != nullptr)
+    {
+        for (size_t i = 0; i < names->size(); ++i)
+            if (equals_ignore_case(token, (*names)[i]))
+                value = first_name_value + static_cast<unsigned>(i);
+    }
+
+    if (!value.has_value() || *value < min || *value > max)
+        return std::nullopt;
+
+    return value;
+}
+
+template <size_t N = 0>
+uint64_t parse_field(
+    const std::string& expression,
+    std::string_view field,
+    std::string_view field_name,
+    unsigned min,
+    unsigned max,
+    const std::array<std::string_view, N>* names = nullptr,
+    unsigned first_name_value = 0)
+{
+    const auto invalid = [&](std::string_view item) {
+        throw_invalid(expression, "invalid " + std::string(field_name) + " \"" + std::string(item) + "\"");
+    };
+
+    uint64_t mask = 0;
+    while (true)
+    {
+        const auto comma = field.find(',');
+        const auto item = field.substr(0, comma);
+
+        const auto slash = item.find('/');
+        const auto range = item.substr(0, slash);
+        unsigned step = 1;
+        if (slash != std::string_view::npos)
+        {
+            const auto parsed_step = parse_number(item.substr(slash + 1));
+            if (!parsed_step.has_value() || *parsed_step == 0)
+                invalid(item);
+
+            step = *parsed_step;
+        }
+
+        unsigned first = min;
+        unsigned last = max;
+        if (range != "*" && range != "?")
+        {
+            const auto dash = range.find('-');
+            const auto parsed_first = parse_value(range.substr(0, dash), min, max, names, first_name_value);
+            const auto parsed_last = dash != std::string_view::npos ? parse_value(range.substr(dash + 1), min, max, names, first_name_value) : parsed_first;
+            if (!parsed_first.has_value() || !parsed_last.has_value() || *parsed_first > *parsed_last)
+                invalid(item);
+
+            first = *parsed_first;
+            // A single value with a step runs up to the field maximum (e.g. 5/15 is 5-59/15 for minutes).
+            last = (dash == std::string_view::npos && slash != std::string_view::npos) ? max : *parsed_last;
+        }
+
+        for (unsigned value = first; value <= last; value += step)
+            mask |= uint64_t{1} << value;
+
+        if (comma == std::string_view::npos)
+            break;
+
+        field.remove_prefix(comma + 1);
+    }
+
+    return mask;
+}
+
+bool is_wildcard(std::string_view field)
+{
+    return field.starts_with('*') || field.starts_with('?');
+}
+
+std::optional<unsigned> next_bit(uint64_t mask, unsigned from)
+{
+    if (from >= 64)
+        return std::nullopt;
+
+    mask >>= from;
+    if (mask == 0)
+        return std::nullopt;
+
+    return from + static_cast<unsigned>(std::countr_zero(mask));
+}
+}
+
+std::ostream& operator<<(std::ostream& stream, const cron_schedule& schedule)
+{
+    return stream << schedule.to_string();
+}
+
+tc::sdk::cron_schedule cron_schedule::from_string(const std::string& expression) noexcept(false)
+{
+    std::string_view fields_expression = expression;
+    for (auto&& m : macros)
+        if (equals_ignore_case(expression, m.name))
+            fields_expression = m.expression;
+
+    std::vector<std::string> fields;
+    std::istringstream ss{std::string(fields_expression)};
+    for (std::string field; ss >> field;)
+        fields.push_back(std::move(field));
+
+    if (fields.size() != 5 && fields.size() != 6)
+        throw_invalid(expression, "expected 5 or 6 fields, found " + std::to_string(fields.size()));
+
+    // Without the seconds field, the schedule runs at the beginning of the minute.
+    const size_t offset = fields.size() - 5;
+    const std::string seconds_field = offset ? fields[0] : "0";
+
+    cron_schedule schedule;
+    schedule._expression = expression;
+    schedule._seconds = parse_field(expression, seconds_field, "seconds", 0, 59);
+    schedule._minutes = parse_field(expression, fields[offset], "minutes", 0, 59);
+    schedule._hours = static_cast<uint32_t>(parse_field(expression, fields[offset + 1], "hours", 0, 23));
+    schedule._days_of_month = static_cast<uint32_t>(parse_field(expression, fields[offset + 2], "day of month", 1, 31));
+    schedule._months = static_cast<uint16_t>(parse_field(expression, fields[offset + 3], "month", 1, 12, &month_names, 1));
+
+    // Both 0 and 7 are Sunday.
+    const auto days_of_week = parse_field(expression, fields[offset + 4], "day of week", 0, 7, &weekday_names, 0);
+    schedule._days_of_week = static_cast<uint8_t>((days_of_week | (days_of_week >> 7)) & all_days_of_week);
+
+    schedule._is_day_of_month_restricted = !is_wildcard(fields[offset + 2]);
+    schedule._is_day_of_week_restricted = !is_wildcard(fields[offset + 4]);
+    return schedule;
+}
+
+std::optional<tc::sdk::datetime> cron_schedule::next(const tc::sdk::datetime& after) const
+{
+    using namespace std::chrono;
+
+    const auto start = floor<seconds>(after.to_time_point()) + 1s;
+    const auto start_days = floor<days>(start);
+    const year_month_day start_ymd{start_days};
+    const hh_mm_ss start_hms{start - start_days};
+
+    int y = static_cast<int>(start_ymd.year());
+    unsigned mo = static_cast<unsigned>(start_ymd.month());
+    unsigned d = static_cast<unsigned>(start_ymd.day());
+    unsigned h = static_cast<unsigned>(start_hms.hours().count());
+    unsigned mi = static_cast<unsigned>(start_hms.minutes().count());
+    unsigned s = static_cast<unsigned>(start_hms.seconds().count());
+
+    // Each field jumps to its next allowed value: when it changes, all the lower fields restart from their minimum,
+    // and when no value is left the higher field is incremented and the search starts over from it.
+    const int last_year = y + max_search_years;
+    while (y <= last_year)
+    {
+        const auto next_month = next_bit(_months, mo);
+        if (!next_month.has_value())
+        {
+            ++y;
+            mo = d = 1;
+            h = mi = s = 0;
+            continue;
+        }
+        if (*next_month != mo)
+        {
+            mo = *next_month;
+            d = 1;
+            h = mi = s = 0;
+        }
+
+        const auto next_d = next_day(year{y}, month{mo}, d);
+        if (!next_d.has_value())
+        {
+            ++mo;
+            d = 1;
+            h = mi = s = 0;
+            continue;
+        }
+        if (*next_d != d)
+        {
+            d = *next_d;
+            h = mi = s = 0;
+        }
+
+        const auto next_h = next_bit(_hours, h);
+        if (!next_h.has_value())
+        {
+            ++d;
+            h = mi = s = 0;
+            continue;
+        }
+        if (*next_h != h)
+        {
+            h = *next_h;
+            mi = s = 0;
+        }
+
+        const auto next_mi = next_bit(_minutes, mi);
+        if (!next_mi.has_value())
+        {
+            ++h;
+            mi = s = 0;
+            continue;
+        }
+        if (*next_mi != mi)
+        {
+            mi = *next_mi;
+            s = 0;
+        }
+
+        const auto next_s = next_bit(_seconds, s);
+        if (!next_s.has_value())
+        {
+            ++mi;
+            s = 0;
+            continue;
+        }
+
+        return tc::sdk::datetime(year{y}, month{mo}, day{d}, hours{h}, minutes{mi}, seconds{*next_s});
+    }
+
+    return std::nullopt;
+}
+
+bool cron_schedule::matches(const tc::sdk::datetime& dt) const
+{
+    using namespace std::chrono;
+
+    const auto tp = floor<seconds>(dt.to_time_point());
+    const auto tp_days = floor<days>(tp);
+    const year_month_day ymd{tp_days};
+    const hh_mm_ss hms{tp - tp_days};
+
+    return (_seconds >> hms.seconds().count()) & 1
+        && (_minutes >> hms.minutes().count()) & 1
+        && (_hours >> hms.hours().count()) & 1
+        && (_months >> static_cast<unsigned>(ymd.month())) & 1
+        && matches_day(static_cast<unsigned>(ymd.day()), weekday{tp_days}.c_encoding());
+}
+
+std::optional<unsigned> cron_schedule::next_day(const std::chrono::year& y, const std::chrono::month& m, unsigned from) const
+{
+    using namespace std::chrono;
+
+    const unsigned last = static_cast<unsigned>((y / m / std::chrono::last).day());
+    if (from > last)
+        return std::nullopt;
+
+    // When every day of the week is allowed (and not in either-or with the day of month), only the day of month bitmask is checked.
+    if (_days_of_week == all_days_of_week && !(_is_day_of_month_restricted && _is_day_of_week_restricted))
+    {
+        const auto d = next_bit(_days_of_month, from);
+        if (d.has_value() && *d <= last)
+            return d;
+
+        return std::nullopt;
+    }
+
+    // Otherwise walk the days of the month (at most 31), advancing the weekday along with the day.
+    unsigned wd = weekday{sys_days{y / m / day{from}}}.c_encoding();
+    for (unsigned d = from; d <= last; ++d, wd = (wd + 1) % 7)
+        if (matches_day(d, wd))
+            return d;
+
+    return std::nullopt;
+}
+
+bool cron_schedule::matches_day(unsigned day, unsigned weekday) const
+{
+    const bool is_day_of_month_allowed = (_days_of_month >> day) & 1;
+    const bool is_day_of_week_allowed = (_days_of_week >> weekday) & 1;
+
+    if (_is_day_of_month_restricted && _is_day_of_week_restricted)
+        return is_day_of_month_allowed || is_day_of_week_allowed;
+
+    return is_day_of_month_allowed && is_day_of_week_allowed;
+}
+
+}
@@ -0,0 +1,73 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <teiacare/sdk/debouncer.hpp>
+
+namespace tc::sdk
+{
+debouncer::debouncer(tc::sdk::task_scheduler& scheduler, tc::sdk::clock::duration delay, std::function<void()> callback)
+    : _scheduler{scheduler}
+    , _delay{delay}
+    , _state{std::make_shared<state>()}
+{
+    _state->callback = std::move(callback);
+
+    // The running count is raised before checking the cancelled flag, so the destructor either sees the callback running or the callback sees the cancellation.
+    _handle = _scheduler.on_demand([s = _state] {
+        if (!s->is_pending.exchange(false))
+            return;
+
+        ++s->running_count;
+        if (!s->is_cancelled)
+            s->callback();
+
+        --s->running_count;
+        s->running_count.notify_all();
+    });
+
+    // The callback runs at most once at a time: a burst triggered while it is running results in a single call afterwards.
+    _scheduler.set_overlap_policy(_handle, tc::sdk::task_scheduler::overlap_policy::coalesce);
+}
+
+debouncer::~debouncer()
+{
+    _state->is_cancelled = true;
+    _scheduler.remove_task(_handle);
+
+    for (auto running_count = _state->running_count.load(); running_count != 0; running_count = _state->running_count.load())
+        _state->running_count.wait(running_count);
+}
+
+bool debouncer::trigger()
+{
+    _state->is_pending = true;
+    if (_scheduler.reschedule(_handle, _scheduler.get_clock()->now() + _delay))
+        return true;
+
+    _state->is_pending = false;
+    return false;
+}
+
+bool debouncer::cancel()
+{
+    // The task is left armed: once it expires it finds no pending call and returns immediately.
+    return _state->is_pending.exchange(false);
+}
+
+bool debouncer::is_pending() const
+{
+    return _state->is_pending;
+}
+
+}
@@ -14,11 +14,121 @@
 
 #include <teiacare/sdk/event_dispatcher.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+
 namespace tc::sdk
 {
+namespace
+{
+// Reader slot of a thread, see event_dispatcher::rcu_domain_t. The slots are never freed: the slot of a terminated thread is reused by the next one.
+struct alignas(64) reader_slot_t
+{
+    std::atomic<uint64_t> epoch{0}; // 0 while the thread is not reading any snapshot.
+    std::atomic<bool> is_used{true};
+    reader_slot_t* next = nullptr;
+};
+
+std::atomic<uint64_t> global_epoch{1};
+std::atomic<reader_slot_t*> reader_slots{nullptr};
+
+class thread_reader_t
+{
+public:
+    thread_reader_t()
+        : slot{acquire_slot()}
+    {
+    }
+
+    ~thread_reader_t()
+    {
+        slot->epoch.store(0);
+        slot->is_used.store(false);
+    }
+
+    reader_slot_t* const slot;
+    size_t depth = 0;
+
+private:
+    static reader_slot_t* acquire_slot()
+    {
+        for (auto free_slot = reader_slots.load(); free_slot != nullptr; free_slot = free_slot->next)
+        {
+            bool is_used = false;
+            if (!free_slot->is_used.load() && free_slot->is_used.compare_exchange_strong(is_used, true))
+                return free_slot;
+        }
+
+        auto new_slot = new reader_slot_t();
+        new_slot->next = reader_slots.load();
+        while (!reader_slots.compare_exchange_weak(new_slot->next, new_slot))
+        {
+        }
+
+        return new_slot;
+    }
+};
+
+thread_reader_t& thread_reader()
+{
+    thread_local thread_reader_t reader;
+    return reader;
+}
+}
+
 unsigned long event_dispatcher::handler_id = 0;
 
+void event_dispatcher::rcu_domain_t::enter() noexcept
+{
+    // The slot is stored before the snapshots are loaded (sequentially consistent store): a writer that does not see it
+    // has published its new snapshot before, and this reader cannot get the replaced one.
+    auto& reader = thread_reader();
+    if (reader.depth++ == 0)
+        reader.slot->epoch.store(global_epoch.load());
+}
+
+bool event_dispatcher::rcu_domain_t::leave() noexcept
+{
+    auto& reader = thread_reader();
+    if (--reader.depth != 0)
+        return false;
+
+    reader.slot->epoch.store(0, std::memory_order_release);
+    return true;
+}
+
+auto event_dispatcher::rcu_domain_t::retire_epoch() noexcept -> epoch_t
+{
+    return global_epoch.fetch_add(1);
+}
+
+auto event_dispatcher::rcu_domain_t::oldest_reader_epoch() noexcept -> epoch_t
+{
+    auto oldest_epoch = std::numeric_limits<epoch_t>::max();
+    for (auto slot = reader_slots.load(); slot != nullptr; slot = slot->next)
+    {
+        if (const auto epoch = slot->epoch.load(); epoch != 0)
+            oldest_epoch = std::min(oldest_epoch, epoch);
+    }
+
+    return oldest_epoch;
+}
+
 event_dispatcher::event_dispatcher() noexcept
+    : _owned_tp{std::in_place}
+    , _tp{*_owned_tp}
+    , _is_running{false}
+    , _hybrid_threshold{std::chrono::duration_cast<tc::sdk::clock::duration>(std::chrono::microseconds(10)).count()}
+{
+}
+
+event_dispatcher::event_dispatcher(tc::sdk::thread_pool& executor) noexcept
+    : _owned_tp{}
+    , _tp{executor}
+    , _is_running{false}
+    , _hybrid_threshold{std::chrono::duration_cast<tc::sdk::clock::duration>(std::chrono::microseconds(10)).count()}
 {
 }
 
@@ -30,15 +140,18 @@ event_dispatcher::~event_dispatcher() noexcept
 
 auto event_dispatcher::remove_handler(unsigned long remove_handler_id) -> bool
 {
-    std::unique_lock handlers_lock(_handlers_mutex);
+    std::scoped_lock events_lock(_events_mutex);
+    const auto events = _events.current();
+    if (events == nullptr)
+        return false;
 
-    for (auto&& event_handlers : _handlers)
+    const auto has_handler_id = [remove_handler_id](auto&& h) { return h->id == remove_handler_id; };
+    for (auto&& [event_key, event] : *events)
     {
-        if (std::erase_if(event_handlers.second, [remove_handler_id](auto&& h) { return h->id == remove_handler_id; }))
+        const auto handlers = event->handlers.current();
+        if (handlers && std::any_of(handlers->begin(), handlers->end(), has_handler_id))
         {
-            if (event_handlers.second.empty())
-                _handlers.erase(event_handlers.first);
-
+            event->update_handlers([&has_handler_id](handlers_list_t& new_handlers) { std::erase_if(new_handlers, has_handler_id); });
             return true;
         }
     }
@@ -48,27 +161,78 @@ auto event_dispatcher::remove_handler(unsigned long remove_handler_id) -> bool
 
 auto event_dispatcher::remove_event(std::string event_name) -> bool
 {
-    std::unique_lock handlers_lock(_handlers_mutex);
+    std::scoped_lock events_lock(_events_mutex);
+    const auto events = _events.current();
+    if (events == nullptr)
+        return false;
 
-    if (std::erase_if(_handlers, [event_name](auto&& handler_iterator) { return handler_iterator.first.starts_with(event_name); }))
-        return true;
+    // The event is removed with all its signatures. The entries are erased from the map, while the events stay alive
+    // for the channels bound to them: their handlers are cleared, so that those channels see the event as removed.
+    auto new_events = std::make_unique<events_map_t>();
+    bool is_removed = false;
+    for (auto&& [event_key, event] : *events)
+    {
+        if (event_key.name != event_name)
+        {
+            new_events->emplace(event_key, event);
+            continue;
+        }
 
-    return false;
+        if (event->handlers.current())
+        {
+            event->clear_handlers();
+            is_removed = true;
+        }
+    }
+
+    if (new_events->size() != events->size())
+        _events.publish(std::move(new_events));
+
+    return is_removed;
+}
+
+void event_dispatcher::set_hybrid_threshold(tc::sdk::clock::duration threshold)
+{
+    _hybrid_threshold = threshold.count();
+}
+
+tc::sdk::clock::duration event_dispatcher::get_hybrid_threshold() const
+{
+    return tc::sdk::clock::duration{_hybrid_threshold.load()};
 }
 
 auto event_dispatcher::start(const unsigned int num_threads) -> bool
 {
-    return _tp.start(num_threads);
+    if (_is_running.exchange(true))
+        return false;
+
+    if (_owned_tp.has_value() && !_owned_tp->start(num_threads))
+    {
+        _is_running = false;
+        return false;
+    }
+
+    return true;
 }
 
 auto event_dispatcher::stop() -> bool
 {
     {
-        std::scoped_lock handlers_lock(_handlers_mutex);
-        _handlers.clear();
+        std::scoped_lock events_lock(_events_mutex);
+        if (const auto events = _events.current())
+        {
+            for (auto&& [event_key, event] : *events)
+                event->clear_handlers();
+        }
     }
 
-    return _tp.stop();
+    if (!_is_running.exchange(false))
+        return false;
+
+    if (_owned_tp.has_value())
+        _owned_tp->stop();
+
+    return true;
 }
 
 }
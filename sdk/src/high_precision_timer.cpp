@@ -19,15 +19,23 @@
 namespace tc::sdk
 {
 high_precision_timer::high_precision_timer()
-    : _is_running{true}
-    , _interval{clock::duration::max()}
+    : high_precision_timer(tc::sdk::clock_source::steady())
+{
+}
+
+high_precision_timer::high_precision_timer(std::shared_ptr<tc::sdk::clock_source> clock)
+    : _clock{clock ? std::move(clock) : tc::sdk::clock_source::steady()}
+    , _is_running{true}
+    , _interval{tc::sdk::clock::duration::max()}
     , _task{nullptr}
 {
+    _clock->subscribe(_worker_cv, _worker_mutex);
 }
 
 high_precision_timer::~high_precision_timer()
 {
     stop();
+    _clock->unsubscribe(_worker_cv);
 }
 
 bool high_precision_timer::start(clock::duration&& interval)
@@ -40,7 +48,7 @@ bool high_precision_timer::start(clock::duration&& interval)
     _invoked_callback_count = 0;
     _missed_callback_count = 0;
 
-    _next_task_timepoint = clock::now() + interval;
+    _next_task_timepoint = _clock->now() + interval;
     _interval = interval;
 
     std::promise<void> thread_started_notifier;
@@ -87,7 +95,10 @@ void high_precision_timer::worker()
     std::unique_lock lock(_worker_mutex);
     while (_is_running)
     {
-        if (_worker_cv.wait_until(lock, _next_task_timepoint, [this] { return !_is_running; }))
+        while (_is_running && _clock->now() < _next_task_timepoint)
+            _clock->wait_until(_worker_cv, lock, _next_task_timepoint);
+
+        if (!_is_running)
             break;
 
         _task->invoke();
@@ -99,8 +110,8 @@ void high_precision_timer::worker()
 void high_precision_timer::update_next_start_time()
 {
     auto task_next_start_time = _next_task_timepoint;
-    const auto now = clock::now();
-    while (now > task_next_start_time)
+    const auto now = _clock->now();
+    while (now >= task_next_start_time)
     {
         task_next_start_time += _interval;
         ++_missed_callback_count;
@@ -14,20 +14,24 @@
 
 #include <teiacare/sdk/rate_limiter.hpp>
 
-#include <thread>
-
 namespace tc::sdk
 {
 rate_limiter::rate_limiter(size_t rate)
-    : time_between_frames{std::chrono::seconds(1) / static_cast<duration_rep>(rate)}
-    , tp{tc::sdk::clock::now()}
+    : rate_limiter(rate, tc::sdk::clock_source::steady())
+{
+}
+
+rate_limiter::rate_limiter(size_t rate, std::shared_ptr<tc::sdk::clock_source> clock)
+    : _clock{clock ? std::move(clock) : tc::sdk::clock_source::steady()}
+    , time_between_frames{std::chrono::seconds(1) / static_cast<duration_rep>(rate)}
+    , tp{_clock->now()}
 {
 }
 
 void rate_limiter::sync()
 {
     tp += time_between_frames;
-    std::this_thread::sleep_until(tp);
+    _clock->sleep_until(std::chrono::ceil<tc::sdk::clock::duration>(tp));
 }
 
 }
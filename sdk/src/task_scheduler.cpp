@@ -14,23 +14,185 @@
 
 #include <teiacare/sdk/task_scheduler.hpp>
 
+#include "task_scheduler/ordered_timer_queue.hpp"
+#include "task_scheduler/slot_pool.hpp"
+#include "task_scheduler/timerfd_waiter.hpp"
+#include "task_scheduler/timing_wheel.hpp"
+
 #include <algorithm>
+#include <bit>
+#include <functional>
+#include <random>
+#include <system_error>
+#include <utility>
 
 namespace tc::sdk
 {
+namespace
+{
+// task_slot::state holds the slot generation in the upper 32 bits and the following flags in the lower 32 bits.
+// Packing them in a single word allows producers and the scheduler thread to update a slot with a single CAS.
+constexpr uint64_t state_live = 1 << 0;         // The slot holds a scheduled task.
+constexpr uint64_t state_enabled = 1 << 1;      // The task is run when it expires.
+constexpr uint64_t state_recurring = 1 << 2;    // The task has been scheduled with every().
+constexpr uint64_t state_busy = 1 << 3;         // A producer is writing the request fields of the slot.
+constexpr uint64_t state_submitted = 1 << 4;    // The slot is linked in the submission stack.
+constexpr uint64_t request_insert = 1 << 5;     // The task has to be inserted in the timer queue.
+constexpr uint64_t request_reschedule = 1 << 6; // The task has to be moved to task_slot::requested_timepoint.
+constexpr uint64_t request_interval = 1 << 7;   // The task has to be rescheduled with the new task_slot::interval.
+constexpr uint64_t state_calendar = 1 << 8;     // The recurring task follows a tc::sdk::cron_schedule rather than an interval.
+constexpr uint64_t request_slack = 1 << 9;      // The task has to be rescheduled with the new task_slot::slack.
+constexpr uint64_t state_rearmed = 1 << 10;     // The recurring task is parked after each run, until it is rescheduled.
+constexpr uint64_t requests_mask = request_insert | request_reschedule | request_interval | request_slack;
+
+constexpr uint32_t generation_of(uint64_t state)
+{
+    return static_cast<uint32_t>(state >> 32);
+}
+
+constexpr uint64_t make_state(uint32_t generation, uint64_t flags)
+{
+    return (uint64_t{generation} << 32) | flags;
+}
+
+// task_slot::slack of the tasks using the default timer slack of the scheduler.
+constexpr tc::sdk::clock::rep default_slack = -1;
+
+// task_state::run_flags of the recursive tasks run with overlap_policy::skip or overlap_policy::coalesce.
+constexpr uint32_t run_running = 1 << 0; // The task is running, or queued in the thread pool.
+constexpr uint32_t run_pending = 1 << 1; // The task has to be run again once its current run completes.
+
+// SplitMix64 finalizer: spreads similar task_ids (or consecutive slot indices) across the whole interval.
+constexpr uint64_t mix_bits(uint64_t value)
+{
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+// Counts the operations in progress on a counter that can be waited for until it drops to zero:
+// captured by the tasks dispatched to the executor, to count the tasks that are queued or running
+// (both when they complete and when they are discarded by a stopped executor), and held by the producers while they write the task slots.
+class activity_guard
+{
+public:
+    explicit activity_guard(std::atomic<size_t>& count) noexcept
+        : _count{&count}
+    {
+        _count->fetch_add(1);
+    }
+
+    activity_guard(activity_guard&& other) noexcept
+        : _count{std::exchange(other._count, nullptr)}
+    {
+    }
+
+    activity_guard(const activity_guard&) = delete;
+    activity_guard& operator=(const activity_guard&) = delete;
+    activity_guard& operator=(activity_guard&&) = delete;
+
+    ~activity_guard()
+    {
+        if (_count != nullptr && _count->fetch_sub(1) == 1)
+            _count->notify_all();
+    }
+
+private:
+    std::atomic<size_t>* _count;
+};
+
+void wait_until_idle(std::atomic<size_t>& count)
+{
+    for (auto value = count.load(); value > 0; value = count.load())
+        count.wait(value);
+}
+}
+
+struct task_scheduler::task_slot
+{
+    std::atomic<uint64_t> state{make_state(1, 0)};
+    std::atomic<tc::sdk::clock::rep> interval{0};
+    std::atomic<tc::sdk::clock::rep> requested_timepoint{0};
+    std::atomic<overlap_policy> overlap{overlap_policy::allow};
+    std::atomic<tc::sdk::clock::rep> slack{default_slack};
+    std::atomic<uint64_t> skipped_runs{0};
+    std::atomic<uint64_t> coalesced_runs{0};
+
+    // Written by the producer before the slot is submitted, then owned by the scheduler thread.
+    slot_index_t next_submitted = 0; // Submission stack link: index + 1, 0 terminates the stack.
+    std::optional<schedulable_task> task;
+    tc::sdk::clock::time_point timepoint; // Nominal start time, before the timer slack is applied.
+    tc::sdk::clock::duration active_interval{0};
+    tc::sdk::sys_time_point calendar_timepoint; // System time of the next run of a task following a tc::sdk::cron_schedule.
+    bool is_pending = false; // The slot is in the timer queue.
+};
+
 task_scheduler::task_scheduler()
+    : task_scheduler(timer_backend::ordered_map)
+{
+}
+
+task_scheduler::task_scheduler(timer_backend backend, tc::sdk::clock::duration resolution)
+    : task_scheduler(tc::sdk::clock_source::steady(), backend, resolution)
+{
+}
+
+task_scheduler::task_scheduler(std::shared_ptr<tc::sdk::clock_source> clock, timer_backend backend, tc::sdk::clock::duration resolution)
+    : task_scheduler(std::move(clock), backend, resolution, nullptr)
+{
+}
+
+task_scheduler::task_scheduler(tc::sdk::thread_pool& executor, timer_backend backend, tc::sdk::clock::duration resolution)
+    : task_scheduler(tc::sdk::clock_source::steady(), backend, resolution, &executor)
+{
+}
+
+task_scheduler::task_scheduler(tc::sdk::thread_pool& executor, std::shared_ptr<tc::sdk::clock_source> clock, timer_backend backend, tc::sdk::clock::duration resolution)
+    : task_scheduler(std::move(clock), backend, resolution, &executor)
 {
 }
 
+task_scheduler::task_scheduler(std::shared_ptr<tc::sdk::clock_source> clock, timer_backend backend, tc::sdk::clock::duration resolution, tc::sdk::thread_pool* executor)
+    : _clock{clock ? std::move(clock) : tc::sdk::clock_source::steady()}
+    , _owned_tp{}
+    , _tp{executor != nullptr ? *executor : _owned_tp.emplace()}
+    , _is_running{false}
+    , _dispatched_tasks_count{0}
+    , _active_producers{0}
+    , _slots{std::make_unique<detail::slot_pool<task_slot>>()}
+    , _tasks_count{0}
+    , _timer_slack{0}
+    , _phase_spreading{phase_spreading::none}
+    , _is_task_stats_enabled{false}
+    , _submitted_slots_head{0}
+    , _is_sleeping{false}
+    , _is_timerfd_failed{false}
+    , _is_polled{false}
+{
+    if (backend == timer_backend::timing_wheel)
+        _timers = std::make_unique<detail::timing_wheel>(resolution, _clock->now());
+    else
+        _timers = std::make_unique<detail::ordered_timer_queue>();
+
+    _clock->subscribe(_wakeup_cv, _wakeup_mtx);
+}
+
 task_scheduler::~task_scheduler()
 {
     stop();
+    _clock->unsubscribe(_wakeup_cv);
 }
 
 bool task_scheduler::start(const unsigned int num_threads)
 {
-    if (!_tp.start(num_threads))
+    if (_is_running.exchange(true))
+        return false;
+
+    if (_owned_tp.has_value() && !_owned_tp->start(num_threads))
+    {
+        _is_running = false;
         return false;
+    }
 
     std::promise<void> thread_started_notifier;
     std::future<void> thread_started_watcher = thread_started_notifier.get_future();
@@ -38,29 +200,11 @@ bool task_scheduler::start(const unsigned int num_threads)
     _scheduler_thread = std::thread([this, &thread_started_notifier] {
         thread_started_notifier.set_value();
 
-        while (_tp.is_running())
+        while (_is_running)
         {
-            std::unique_lock lock(_update_tasks_mtx);
-
-            if (_tasks.empty())
-            {
-                _update_tasks_cv.wait(lock, [this] { return !_tp.is_running() || !_tasks.empty(); });
-            }
-            else
-            {
-                // If the last enqueued task is the first to be scheduled _next_task_timepoint must be updated to its timepoint.
-                // Check if the condition variable _update_tasks_cv is triggered because of a timeout (i.e. _next_task_timepoint has just been reached),
-                // or because of a new notification (i.e. a new task has been enqueued and the condition variable is notified):
-                // in case of a timeout proceed with update_tasks(), otherwise continue.
-                _next_task_timepoint = _tasks.begin()->first;
-                if (_update_tasks_cv.wait_until(lock, _next_task_timepoint.load()) == std::cv_status::no_timeout)
-                    continue;
-            }
-
-            if (!_tp.is_running())
-                return;
-
+            drain_submissions();
             update_tasks();
+            wait_for_work();
         }
     });
 
@@ -69,184 +213,1066 @@ bool task_scheduler::start(const unsigned int num_threads)
     return true;
 }
 
-bool task_scheduler::stop()
+bool task_scheduler::start_polled(const unsigned int num_threads)
 {
-    if (!_tp.stop())
+    if (!is_timerfd_active() || _is_running.exchange(true))
         return false;
 
-    _update_tasks_cv.notify_all();
+    if (_owned_tp.has_value() && !_owned_tp->start(num_threads))
+    {
+        _is_running = false;
+        return false;
+    }
+
+    // Without a scheduler thread, every submission has to signal the event loop.
+    _is_polled = true;
+    _is_sleeping = true;
+    return true;
+}
+
+void task_scheduler::poll()
+{
+    if (!_is_polled || !_is_running)
+        return;
+
+    _timerfd_waiter->reset();
+    drain_submissions();
+    update_tasks();
+    arm_timerfd();
+}
+
+bool task_scheduler::stop()
+{
+    if (!_is_running.exchange(false))
+        return false;
 
     {
-        std::scoped_lock lock(_update_tasks_mtx);
-        _tasks.clear();
+        std::scoped_lock lock(_wakeup_mtx);
     }
+    _wakeup_cv.notify_all();
+
+    if (_timerfd_waiter)
+        _timerfd_waiter->notify();
 
     if (_scheduler_thread.joinable())
         _scheduler_thread.join();
 
+    // The tasks queued in the internal thread pool are discarded, while the ones dispatched to an external executor
+    // are waited for: they reference this task_scheduler.
+    if (_owned_tp.has_value())
+        _owned_tp->stop();
+
+    for (auto count = _dispatched_tasks_count.load(); count > 0 && _tp.is_running(); count = _dispatched_tasks_count.load())
+        _dispatched_tasks_count.wait(count);
+
+    // Producers that passed the _is_running check before it was cleared may still be writing their slots.
+    wait_until_idle(_active_producers);
+    clear_tasks();
+
+    if (_timerfd_waiter)
+    {
+        _timerfd_waiter->disarm();
+        _timerfd_waiter->reset();
+    }
+
+    _is_polled = false;
+    _is_sleeping = false;
     return true;
 }
 
+const std::shared_ptr<tc::sdk::clock_source>& task_scheduler::get_clock() const
+{
+    return _clock;
+}
+
+bool task_scheduler::set_wakeup_backend(wakeup_backend backend)
+{
+    if (_is_running)
+        return false;
+
+    _is_timerfd_failed = false;
+    if (backend == wakeup_backend::condition_variable)
+    {
+        _timerfd_waiter.reset();
+        return true;
+    }
+
+    // The timerfd deadlines are armed on CLOCK_MONOTONIC: they cannot follow a virtual clock.
+    if (dynamic_cast<const tc::sdk::steady_clock_source*>(_clock.get()) == nullptr)
+        return false;
+
+    if (!_timerfd_waiter)
+        _timerfd_waiter = detail::timerfd_waiter::create();
+
+    return _timerfd_waiter != nullptr;
+}
+
+auto task_scheduler::get_wakeup_backend() const -> wakeup_backend
+{
+    return is_timerfd_active() ? wakeup_backend::timerfd : wakeup_backend::condition_variable;
+}
+
+int task_scheduler::native_handle() const
+{
+    return is_timerfd_active() ? _timerfd_waiter->native_handle() : -1;
+}
+
 size_t task_scheduler::tasks_size()
 {
-    std::scoped_lock lock(_update_tasks_mtx);
-    return _tasks.size();
+    return _tasks_count.load();
 }
 
 bool task_scheduler::is_scheduled(const std::string& task_id)
 {
-    std::scoped_lock lock(_update_tasks_mtx);
-    return get_task_iterator(task_id) != _tasks.end();
+    auto handle = get_task_handle(task_id);
+    return handle.has_value() && is_scheduled(*handle);
 }
 
-bool task_scheduler::is_enabled(const std::string& task_id)
+bool task_scheduler::is_scheduled(task_handle handle)
 {
-    std::scoped_lock lock(_update_tasks_mtx);
-    if (auto task = get_task_iterator(task_id); task != _tasks.end())
-        return task->second.is_enabled();
+    if (auto task_slot = get_task_slot(handle); task_slot != nullptr)
+    {
+        const auto state = task_slot->state.load();
+        return generation_of(state) == handle._generation && (state & state_live);
+    }
 
     return false;
 }
 
-bool task_scheduler::set_enabled(const std::string& task_id, bool is_enabled)
+bool task_scheduler::is_enabled(const std::string& task_id)
+{
+    auto handle = get_task_handle(task_id);
+    return handle.has_value() && is_enabled(*handle);
+}
+
+bool task_scheduler::is_enabled(task_handle handle)
 {
-    std::scoped_lock lock(_update_tasks_mtx);
-    if (auto task = get_task_iterator(task_id); task != _tasks.end())
+    if (auto task_slot = get_task_slot(handle); task_slot != nullptr)
     {
-        task->second.set_enabled(is_enabled);
-        return true;
+        const auto state = task_slot->state.load();
+        return generation_of(state) == handle._generation && (state & state_live) && (state & state_enabled);
     }
 
     return false;
 }
 
+bool task_scheduler::set_enabled(const std::string& task_id, bool is_enabled)
+{
+    auto handle = get_task_handle(task_id);
+    return handle.has_value() && set_enabled(*handle, is_enabled);
+}
+
+bool task_scheduler::set_enabled(task_handle handle, bool is_enabled)
+{
+    auto task_slot = get_task_slot(handle);
+    if (task_slot == nullptr)
+        return false;
+
+    auto state = task_slot->state.load();
+    do
+    {
+        if (generation_of(state) != handle._generation || !(state & state_live))
+            return false;
+    } while (!task_slot->state.compare_exchange_weak(state, is_enabled ? state | state_enabled : state & ~state_enabled));
+
+    return true;
+}
+
 bool task_scheduler::remove_task(const std::string& task_id)
 {
-    std::scoped_lock lock(_update_tasks_mtx);
-    if (auto task = get_task_iterator(task_id); task != _tasks.end())
+    std::optional<task_handle> handle;
     {
-        _tasks.erase(task);
-        return true;
+        std::scoped_lock lock(_task_ids_mtx);
+        if (auto task_id_iterator = _task_ids.find(task_id); task_id_iterator != _task_ids.end())
+        {
+            handle = task_id_iterator->second;
+            _task_ids.erase(task_id_iterator);
+        }
     }
 
-    return false;
+    return handle.has_value() && remove_task(*handle);
 }
 
-std::optional<sdk::clock::duration> task_scheduler::get_interval(const std::string& task_id)
+bool task_scheduler::remove_task(task_handle handle)
 {
-    std::scoped_lock lock(_update_tasks_mtx);
-    if (auto task_iterator = get_task_iterator(task_id); task_iterator != _tasks.end() && task_iterator->second.interval().has_value())
+    const activity_guard producer_guard(_active_producers);
+    auto task_slot = _is_running ? get_task_slot(handle) : nullptr;
+    if (task_slot == nullptr)
+        return false;
+
+    // The task is no longer scheduled as soon as its live flag is cleared:
+    // the slot is submitted so that the scheduler thread removes its timer and releases it.
+    auto state = task_slot->state.load();
+    do
     {
-        return task_iterator->second.interval();
-    }
+        if (generation_of(state) != handle._generation || !(state & state_live))
+            return false;
+
+        state &= ~state_busy;
+    } while (!task_slot->state.compare_exchange_weak(state, (state & ~(state_live | state_enabled)) | state_submitted));
+
+    --_tasks_count;
+
+    if (!(state & state_submitted))
+        submit(handle._index);
+
+    wake_up();
+    return true;
+}
+
+std::optional<sdk::clock::duration> task_scheduler::get_interval(const std::string& task_id)
+{
+    if (auto handle = get_task_handle(task_id); handle.has_value())
+        return get_interval(*handle);
 
     return std::nullopt;
 }
 
+std::optional<sdk::clock::duration> task_scheduler::get_interval(task_handle handle)
+{
+    auto task_slot = get_task_slot(handle);
+    if (task_slot == nullptr)
+        return std::nullopt;
+
+    // Read the interval between two checks of the slot state, so that the interval of a different task is never returned.
+    const auto state = task_slot->state.load();
+    if (generation_of(state) != handle._generation || !(state & state_live) || !(state & state_recurring) || (state & (state_calendar | state_rearmed)))
+        return std::nullopt;
+
+    const auto interval = tc::sdk::clock::duration{task_slot->interval.load()};
+    if (generation_of(task_slot->state.load()) != handle._generation)
+        return std::nullopt;
+
+    return interval;
+}
+
 bool task_scheduler::update_interval(const std::string& task_id, interval_t interval)
 {
-    std::unique_lock lock(_update_tasks_mtx);
-    if (auto task_iterator = get_task_iterator(task_id); task_iterator != _tasks.end() && task_iterator->second.interval().has_value())
+    auto handle = get_task_handle(task_id);
+    return handle.has_value() && update_interval(*handle, interval);
+}
+
+bool task_scheduler::update_interval(task_handle handle, interval_t interval)
+{
+    return submit_request(handle, request_interval, [interval](task_slot& s) { s.interval.store(interval.count()); });
+}
+
+bool task_scheduler::reschedule(const std::string& task_id, tc::sdk::clock::time_point timepoint)
+{
+    auto handle = get_task_handle(task_id);
+    return handle.has_value() && reschedule(*handle, timepoint);
+}
+
+bool task_scheduler::reschedule(task_handle handle, tc::sdk::clock::time_point timepoint)
+{
+    return submit_request(handle, request_reschedule, [timepoint](task_slot& s) { s.requested_timepoint.store(timepoint.time_since_epoch().count()); });
+}
+
+bool task_scheduler::set_overlap_policy(const std::string& task_id, overlap_policy policy)
+{
+    auto handle = get_task_handle(task_id);
+    return handle.has_value() && set_overlap_policy(*handle, policy);
+}
+
+bool task_scheduler::set_overlap_policy(task_handle handle, overlap_policy policy)
+{
+    // The busy flag prevents the slot from being released and reused by another task while the policy is written.
+    auto task_slot = get_task_slot(handle);
+    if (task_slot == nullptr)
+        return false;
+
+    auto state = task_slot->state.load();
+    do
     {
-        const auto task_interval = task_iterator->second.interval().value();
-        auto task_next_start_time = task_iterator->first - task_interval;
+        if (generation_of(state) != handle._generation || !(state & state_live) || !(state & state_recurring))
+            return false;
 
-        const auto now = tc::sdk::clock::now();
-        while (now > task_next_start_time)
-            task_next_start_time += interval;
+        state &= ~state_busy;
+    } while (!task_slot->state.compare_exchange_weak(state, state | state_busy));
 
-        task_iterator->second.set_interval(interval);
-        _tasks.emplace(std::move(task_next_start_time), std::move(task_iterator->second));
-        _tasks.erase(task_iterator);
-        lock.unlock();
+    task_slot->overlap.store(policy);
+    task_slot->state.fetch_and(~state_busy);
+    return true;
+}
 
-        _update_tasks_cv.notify_one();
-        return true;
+auto task_scheduler::get_overlap_stats(const std::string& task_id) -> std::optional<overlap_stats>
+{
+    if (auto handle = get_task_handle(task_id); handle.has_value())
+        return get_overlap_stats(*handle);
+
+    return std::nullopt;
+}
+
+auto task_scheduler::get_overlap_stats(task_handle handle) -> std::optional<overlap_stats>
+{
+    auto task_slot = get_task_slot(handle);
+    if (task_slot == nullptr)
+        return std::nullopt;
+
+    // Read the counters between two checks of the slot state, so that the counters of a different task are never returned.
+    const auto state = task_slot->state.load();
+    if (generation_of(state) != handle._generation || !(state & state_live) || !(state & state_recurring))
+        return std::nullopt;
+
+    const overlap_stats stats{task_slot->skipped_runs.load(), task_slot->coalesced_runs.load()};
+    if (generation_of(task_slot->state.load()) != handle._generation)
+        return std::nullopt;
+
+    return stats;
+}
+
+void task_scheduler::set_timer_slack(tc::sdk::clock::duration slack)
+{
+    _timer_slack.store(std::max(slack, tc::sdk::clock::duration{0}).count());
+}
+
+tc::sdk::clock::duration task_scheduler::get_timer_slack() const
+{
+    return tc::sdk::clock::duration{_timer_slack.load()};
+}
+
+bool task_scheduler::set_timer_slack(const std::string& task_id, tc::sdk::clock::duration slack)
+{
+    auto handle = get_task_handle(task_id);
+    return handle.has_value() && set_timer_slack(*handle, slack);
+}
+
+bool task_scheduler::set_timer_slack(task_handle handle, tc::sdk::clock::duration slack)
+{
+    const auto task_slack = std::max(slack, tc::sdk::clock::duration{0});
+    return submit_request(handle, request_slack, [task_slack](task_slot& s) { s.slack.store(task_slack.count()); });
+}
+
+void task_scheduler::set_phase_spreading(phase_spreading spreading)
+{
+    _phase_spreading.store(spreading);
+}
+
+auto task_scheduler::get_phase_spreading() const -> phase_spreading
+{
+    return _phase_spreading.load();
+}
+
+void task_scheduler::set_task_stats_enabled(bool is_enabled)
+{
+    _is_task_stats_enabled.store(is_enabled);
+}
+
+bool task_scheduler::is_task_stats_enabled() const
+{
+    return _is_task_stats_enabled.load();
+}
+
+auto task_scheduler::get_task_stats(const std::string& task_id) -> std::optional<task_stats>
+{
+    if (auto handle = get_task_handle(task_id); handle.has_value())
+        return get_task_stats(*handle);
+
+    return std::nullopt;
+}
+
+auto task_scheduler::get_task_stats(task_handle handle) -> std::optional<task_stats>
+{
+    // The busy flag prevents the slot from being released while the task state is retrieved:
+    // the counters are then read from the task state, which is kept alive by the shared_ptr.
+    auto task_slot = get_task_slot(handle);
+    if (task_slot == nullptr)
+        return std::nullopt;
+
+    auto state = task_slot->state.load();
+    do
+    {
+        if (generation_of(state) != handle._generation || !(state & state_live))
+            return std::nullopt;
+
+        state &= ~state_busy;
+    } while (!task_slot->state.compare_exchange_weak(state, state | state_busy));
+
+    const auto task_state = task_slot->task->state();
+    task_slot->state.fetch_and(~state_busy);
+
+    if (!task_state->stats)
+        return std::nullopt;
+
+    task_stats stats;
+    stats.lateness = task_state->stats->lateness.snapshot();
+    stats.duration = task_state->stats->duration.snapshot();
+    stats.missed_periods = task_state->stats->missed_periods.load(std::memory_order_relaxed);
+    return stats;
+}
+
+tc::sdk::clock::duration task_scheduler::duration_histogram::mean() const
+{
+    return count == 0 ? tc::sdk::clock::duration{0} : total / static_cast<tc::sdk::clock::rep>(count);
+}
+
+tc::sdk::clock::duration task_scheduler::duration_histogram::percentile(double p) const
+{
+    const auto rank = static_cast<uint64_t>(std::clamp(p, 0.0, 1.0) * static_cast<double>(count));
+    uint64_t cumulative_count = 0;
+    for (size_t n = 0; n < buckets_count - 1; ++n)
+    {
+        cumulative_count += buckets[n];
+        if (cumulative_count > rank)
+            return std::min<tc::sdk::clock::duration>(std::chrono::microseconds(uint64_t{1} << n), max);
     }
 
-    return false;
+    return max;
 }
 
-bool task_scheduler::add_task(tc::sdk::clock::time_point&& timepoint, schedulable_task&& st)
+void task_scheduler::duration_counters::record(tc::sdk::clock::duration d)
 {
-    if (!_tp.is_running())
+    d = std::max(d, tc::sdk::clock::duration{0});
+
+    const auto us = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(d).count());
+    const auto bucket = std::min<size_t>(std::bit_width(us), duration_histogram::buckets_count - 1);
+    buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(d.count(), std::memory_order_relaxed);
+
+    auto current_max = max.load(std::memory_order_relaxed);
+    while (d.count() > current_max && !max.compare_exchange_weak(current_max, d.count(), std::memory_order_relaxed))
+    {
+    }
+}
+
+auto task_scheduler::duration_counters::snapshot() const -> duration_histogram
+{
+    duration_histogram histogram;
+    histogram.count = count.load(std::memory_order_relaxed);
+    histogram.total = tc::sdk::clock::duration{total.load(std::memory_order_relaxed)};
+    histogram.max = tc::sdk::clock::duration{max.load(std::memory_order_relaxed)};
+    for (size_t n = 0; n < duration_histogram::buckets_count; ++n)
+        histogram.buckets[n] = buckets[n].load(std::memory_order_relaxed);
+
+    return histogram;
+}
+
+auto task_scheduler::get_dispatch_stats() const -> dispatch_stats
+{
+    dispatch_stats stats;
+    stats.wakeups = _dispatch_counters.wakeups.load(std::memory_order_relaxed);
+    stats.ticks = _dispatch_counters.ticks.load(std::memory_order_relaxed);
+    stats.dispatched_tasks = _dispatch_counters.dispatched_tasks.load(std::memory_order_relaxed);
+    stats.max_tasks_per_tick = _dispatch_counters.max_tasks_per_tick.load(std::memory_order_relaxed);
+    for (size_t n = 0; n < dispatch_stats::histogram_size; ++n)
+        stats.tasks_per_tick[n] = _dispatch_counters.tasks_per_tick[n].load(std::memory_order_relaxed);
+
+    return stats;
+}
+
+void task_scheduler::reset_dispatch_stats()
+{
+    _dispatch_counters.wakeups.store(0, std::memory_order_relaxed);
+    _dispatch_counters.ticks.store(0, std::memory_order_relaxed);
+    _dispatch_counters.dispatched_tasks.store(0, std::memory_order_relaxed);
+    _dispatch_counters.max_tasks_per_tick.store(0, std::memory_order_relaxed);
+    for (auto&& counter : _dispatch_counters.tasks_per_tick)
+        counter.store(0, std::memory_order_relaxed);
+}
+
+auto task_scheduler::add_task(tc::sdk::clock::time_point&& timepoint, schedulable_task&& st) -> task_handle
+{
+    const activity_guard producer_guard(_active_producers);
+    if (!_is_running)
+        return task_handle{};
+
+    // Only the tasks with a task_id synchronize on the task_id index, in order to check for duplicates.
+    std::unique_lock task_ids_lock(_task_ids_mtx, std::defer_lock);
+    if (st.id().has_value())
+    {
+        task_ids_lock.lock();
+        if (auto task_id_iterator = _task_ids.find(st.id().value()); task_id_iterator != _task_ids.end() && is_scheduled(task_id_iterator->second))
+            return task_handle{};
+    }
+
+    // Tasks following a calendar start at the first time matching their schedule.
+    tc::sdk::sys_time_point calendar_timepoint;
+    if (const auto& schedule = st.schedule(); schedule.has_value())
+    {
+        const auto system_now = _clock->system_now();
+        const auto next_run = schedule->next(tc::sdk::datetime(system_now));
+        if (!next_run.has_value())
+            return task_handle{};
+
+        calendar_timepoint = next_run->to_time_point();
+        timepoint = _clock->now() + std::chrono::duration_cast<tc::sdk::clock::duration>(calendar_timepoint - system_now);
+    }
+
+    const auto index = _slots->allocate();
+    if (!index.has_value())
+        return task_handle{};
+
+    auto& task_slot = slot(*index);
+    const auto interval = st.interval();
+    const bool is_calendar = st.schedule().has_value();
+    if (interval.has_value())
+        timepoint += phase_offset(st, *index, *interval);
+
+    auto& task = task_slot.task.emplace(std::move(st));
+    if (_is_task_stats_enabled.load())
+        task.state()->stats = std::make_unique<task_stats_counters>();
+    task_slot.timepoint = timepoint;
+    task_slot.calendar_timepoint = calendar_timepoint;
+    task_slot.active_interval = interval.value_or(tc::sdk::clock::duration{0});
+    task_slot.interval.store(task_slot.active_interval.count());
+    task_slot.overlap.store(overlap_policy::allow);
+    task_slot.slack.store(default_slack);
+    task_slot.skipped_runs.store(0);
+    task_slot.coalesced_runs.store(0);
+
+    ++_tasks_count;
+
+    const auto generation = generation_of(task_slot.state.load());
+    auto flags = state_live | state_enabled | state_submitted | request_insert;
+    if (interval.has_value())
+        flags |= state_recurring;
+    else if (is_calendar)
+        flags |= state_recurring | state_calendar;
+    else if (task.is_rearmed())
+        flags = state_live | state_enabled | state_recurring | state_rearmed; // Parked until its first reschedule() request.
+
+    task_slot.state.store(make_state(generation, flags));
+
+    const task_handle handle(*index, generation);
+    if (const auto& task_id = task.id(); task_id.has_value())
+    {
+        _task_ids.insert_or_assign(task_id.value(), handle);
+        task_ids_lock.unlock();
+    }
+
+    if (flags & state_submitted)
+    {
+        submit(*index);
+        wake_up();
+    }
+
+    return handle;
+}
+
+auto task_scheduler::get_task_handle(const std::string& task_id) -> std::optional<task_handle>
+{
+    std::scoped_lock lock(_task_ids_mtx);
+    if (auto task_id_iterator = _task_ids.find(task_id); task_id_iterator != _task_ids.end())
+        return task_id_iterator->second;
+
+    return std::nullopt;
+}
+
+auto task_scheduler::get_task_slot(task_handle handle) const -> task_slot*
+{
+    if (!handle.is_valid())
+        return nullptr;
+
+    return _slots->find(handle._index);
+}
+
+auto task_scheduler::slot(slot_index_t index) const -> task_slot&
+{
+    return (*_slots)[index];
+}
+
+void task_scheduler::release_slot(slot_index_t index)
+{
+    // Only called by the scheduler thread (or by stop(), once it has been joined) when the slot is no longer live:
+    // producers cannot modify the slot anymore, apart from checking that their handle has expired.
+    auto& task_slot = slot(index);
+    auto generation = generation_of(task_slot.state.load());
+
+    if (task_slot.task.has_value())
+    {
+        if (const auto& task_id = task_slot.task->id(); task_id.has_value())
+        {
+            // The task_id may have already been removed, or even reused by a new task.
+            std::scoped_lock lock(_task_ids_mtx);
+            if (auto task_id_iterator = _task_ids.find(task_id.value()); task_id_iterator != _task_ids.end() && task_id_iterator->second == task_handle(index, generation))
+                _task_ids.erase(task_id_iterator);
+        }
+
+        task_slot.task.reset();
+    }
+
+    // Bump the generation so that the handles of the released task expire (generation 0 is reserved for invalid handles).
+    if (++generation == 0)
+        ++generation;
+
+    task_slot.state.store(make_state(generation, 0));
+    _slots->release(index);
+}
+
+template <typename WriteFunction>
+bool task_scheduler::submit_request(task_handle handle, uint64_t request, WriteFunction&& write)
+{
+    const activity_guard producer_guard(_active_producers);
+    auto task_slot = _is_running ? get_task_slot(handle) : nullptr;
+    if (task_slot == nullptr)
         return false;
 
+    // Set the busy flag while writing the request fields:
+    // the slot cannot be removed, and thus released and reused by another task, in the meantime.
+    auto state = task_slot->state.load();
+    do
     {
-        std::scoped_lock lock(_update_tasks_mtx);
+        if (generation_of(state) != handle._generation || !(state & state_live))
+            return false;
 
-        if (already_exists(st.hash()))
+        if ((request & request_interval) && (!(state & state_recurring) || (state & (state_calendar | state_rearmed))))
             return false;
 
-        _tasks.emplace(std::move(timepoint), std::move(st));
+        state &= ~state_busy;
+    } while (!task_slot->state.compare_exchange_weak(state, state | state_busy));
+
+    write(*task_slot);
+
+    state = task_slot->state.load();
+    while (!task_slot->state.compare_exchange_weak(state, (state | request | state_submitted) & ~state_busy))
+    {
     }
 
-    _update_tasks_cv.notify_one();
+    if (!(state & state_submitted))
+        submit(handle._index);
+
+    wake_up();
     return true;
 }
 
-void task_scheduler::update_tasks()
+void task_scheduler::submit(slot_index_t index)
 {
-    decltype(_tasks) recursive_tasks;
+    // Treiber stack push: the scheduler thread unlinks the whole stack at once, so there is no ABA problem.
+    auto& task_slot = slot(index);
+    auto head = _submitted_slots_head.load();
+    do
+    {
+        task_slot.next_submitted = head;
+    } while (!_submitted_slots_head.compare_exchange_weak(head, index + 1));
+}
 
-    // All the tasks whose start time is before tc::sdk::clock::now(),
-    // (which are the ones from _tasks.begin(), up to last_task_to_process)
-    // can be enqueued in the TaskPool.
-    auto last_task_to_process = _tasks.upper_bound(tc::sdk::clock::now());
-    for (auto it = _tasks.begin(); it != last_task_to_process; it++)
+void task_scheduler::wake_up()
+{
+    // The scheduler thread sets _is_sleeping before checking the submission stack for the last time:
+    // if it is not set, the new submission will be drained without waiting.
+    // Otherwise the mutex is acquired only to make sure that the scheduler thread is actually waiting.
+    if (!_is_sleeping.load())
+        return;
+
+    // The eventfd keeps the notification until it is consumed: no lock is needed.
+    if (is_timerfd_active())
     {
-        if (it->second.is_enabled())
+        _timerfd_waiter->notify();
+        return;
+    }
+
+    {
+        std::scoped_lock lock(_wakeup_mtx);
+    }
+    _wakeup_cv.notify_one();
+}
+
+bool task_scheduler::is_timerfd_active() const
+{
+    return _timerfd_waiter != nullptr && !_is_timerfd_failed.load();
+}
+
+void task_scheduler::wait_for_work()
+{
+    if (is_timerfd_active())
+    {
+        _is_sleeping = true;
+        try
         {
-            _tp.run([t = it->second.clone()] { t->invoke(); });
+            if (_is_running && _submitted_slots_head.load() == 0)
+            {
+                arm_timerfd();
+                _timerfd_waiter->wait();
+            }
+
+            _is_sleeping = false;
+            return;
         }
+        catch (const std::system_error&)
+        {
+            // A timer that cannot be armed would never wake the scheduler thread up, and a failing wait would make it spin:
+            // switch to the condition variable for good. The producers that still saw the timerfd backend active
+            // pushed their request before the switch, so the check of the submission stack below does not miss it.
+            _is_timerfd_failed = true;
+        }
+    }
+
+    std::unique_lock lock(_wakeup_mtx);
+    _is_sleeping = true;
+
+    if (_is_running && _submitted_slots_head.load() == 0)
+    {
+        if (_timers->empty())
+            _clock->wait(_wakeup_cv, lock);
+        else
+            _clock->wait_until(_wakeup_cv, lock, _timers->next_expiry());
+    }
+
+    _is_sleeping = false;
+}
+
+void task_scheduler::arm_timerfd()
+{
+    if (_timers->empty())
+        _timerfd_waiter->disarm();
+    else
+        _timerfd_waiter->arm(_timers->next_expiry());
+}
+
+void task_scheduler::drain_submissions()
+{
+    // Unlink the whole stack at once, then process the slots in submission order (the stack links the most recent first).
+    _submitted_slots.clear();
+    for (auto link = _submitted_slots_head.exchange(0); link != 0; link = slot(link - 1).next_submitted)
+        _submitted_slots.push_back(link - 1);
+
+    const auto now = _clock->now();
+    for (auto index_iterator = _submitted_slots.rbegin(); index_iterator != _submitted_slots.rend(); ++index_iterator)
+    {
+        const auto index = *index_iterator;
+        auto& task_slot = slot(index);
+        const auto state = task_slot.state.fetch_and(~(state_submitted | requests_mask));
 
-        // Keep track of recursive tasks if task has a valid interval value.
-        if (it->second.interval().has_value())
+        // Removed tasks (or one-shot tasks expired while submitted) are released.
+        if (!(state & state_live))
         {
-            // Make sure that next_start_time is greater than tc::sdk::clock::now(),
-            // otherwise the task is scheduled in the past.
-            // Increment next_start_time starting from current start_time with a step equal to t->interval().value()
-            // in order to keep the scheduling with a fixed sample rate.
-            const auto task_interval = it->second.interval().value();
-            auto task_next_start_time = it->first + task_interval;
-            const auto now = tc::sdk::clock::now();
+            if (task_slot.is_pending)
+                _timers->erase(index);
+
+            task_slot.is_pending = false;
+            release_slot(index);
+            continue;
+        }
+
+        if (state & request_insert)
+            insert_timer(index);
+
+        if (state & request_interval)
+        {
+            // Keep the task phase, starting from its last run (or its start time if it has never been run).
+            const auto interval = tc::sdk::clock::duration{task_slot.interval.load()};
+            auto task_next_start_time = task_slot.timepoint - task_slot.active_interval;
             while (now > task_next_start_time)
-                task_next_start_time += task_interval;
+                task_next_start_time += interval;
+
+            task_slot.active_interval = interval;
+            reschedule_slot(index, task_next_start_time);
+        }
+
+        if (state & request_reschedule)
+        {
+            const auto timepoint = tc::sdk::clock::time_point{tc::sdk::clock::duration{task_slot.requested_timepoint.load()}};
+
+            // Calendar schedules resume from the new start time.
+            if (state & state_calendar)
+                task_slot.calendar_timepoint = _clock->system_now() + (timepoint - now);
 
-            recursive_tasks.emplace(std::move(task_next_start_time), std::move(it->second));
+            reschedule_slot(index, timepoint);
         }
+
+        // Parked tasks keep waiting for their reschedule() request.
+        if ((state & request_slack) && task_slot.is_pending)
+            reschedule_slot(index, task_slot.timepoint);
     }
+}
 
-    // Erase tasks already processed.
-    _tasks.erase(_tasks.begin(), last_task_to_process);
+void task_scheduler::update_tasks()
+{
+    // All the tasks whose start time is before the current time can be enqueued in the TaskPool.
+    // Recursive tasks are re-scheduled in their slot (without any new allocation), while one-shot tasks are released.
+    const auto now = _clock->now();
+    _expired_slots.clear();
+    _timers->pop_expired(now, _expired_slots);
+
+    uint64_t dispatched_tasks = 0;
+    for (const auto index : _expired_slots)
+    {
+        auto& task_slot = slot(index);
+        task_slot.is_pending = false;
+        auto state = task_slot.state.load();
+
+        // Removed tasks are released once their submission is drained.
+        if (!(state & state_live))
+            continue;
+
+        if (state & state_rearmed)
+        {
+            if ((state & state_enabled) && run_recursive_task(task_slot))
+                ++dispatched_tasks;
+
+            continue;
+        }
+
+        if (state & state_recurring)
+        {
+            if (const auto task_next_start_time = next_start_time(task_slot, now); task_next_start_time.has_value())
+            {
+                if ((state & state_enabled) && run_recursive_task(task_slot))
+                    ++dispatched_tasks;
+
+                task_slot.timepoint = *task_next_start_time;
+                insert_timer(index);
+                continue;
+            }
+
+            // A calendar schedule with no further match is run one last time as a one-shot task.
+        }
 
-    // Re-schedule recursive tasks.
-    _tasks.merge(recursive_tasks);
+        // One-shot tasks are no longer scheduled once expired, unless they have been removed in the meantime.
+        bool is_expired = false;
+        while (state & state_live)
+        {
+            if (state & state_busy)
+                state = task_slot.state.load();
+            else if (task_slot.state.compare_exchange_weak(state, state & ~(state_live | state_enabled)))
+                is_expired = true;
+
+            if (is_expired)
+                break;
+        }
+
+        if (!is_expired)
+            continue;
+
+        --_tasks_count;
+
+        if (state & state_enabled)
+        {
+            _tp.execute([this, s = task_slot.task->state(), timepoint = task_slot.timepoint, g = activity_guard(_dispatched_tasks_count)] { run_task(*s, timepoint); });
+            ++dispatched_tasks;
+        }
+
+        // Slots with pending requests are released once their submission is drained.
+        if (!(state & state_submitted))
+            release_slot(index);
+    }
+
+    record_tick(dispatched_tasks);
 }
 
-auto task_scheduler::get_task_iterator(const std::string& task_id) -> decltype(_tasks)::iterator
+void task_scheduler::record_tick(uint64_t dispatched_tasks)
 {
-    return std::find_if(_tasks.begin(), _tasks.end(), [hash = _hasher(task_id)](auto&& it) {
-        if (it.second.hash().has_value())
+    // Relaxed read-modify-write sequences are enough, since the counters are written by the scheduler thread only.
+    auto& counters = _dispatch_counters;
+    counters.wakeups.store(counters.wakeups.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (dispatched_tasks == 0)
+        return;
+
+    counters.ticks.store(counters.ticks.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    counters.dispatched_tasks.store(counters.dispatched_tasks.load(std::memory_order_relaxed) + dispatched_tasks, std::memory_order_relaxed);
+    if (dispatched_tasks > counters.max_tasks_per_tick.load(std::memory_order_relaxed))
+        counters.max_tasks_per_tick.store(dispatched_tasks, std::memory_order_relaxed);
+
+    const auto bucket = std::min<size_t>(std::bit_width(dispatched_tasks) - 1, dispatch_stats::histogram_size - 1);
+    auto& counter = counters.tasks_per_tick[bucket];
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+auto task_scheduler::next_start_time(task_slot& task_slot, tc::sdk::clock::time_point now) const -> std::optional<tc::sdk::clock::time_point>
+{
+    if (const auto& schedule = task_slot.task->schedule(); schedule.has_value())
+    {
+        // The next match is searched from the last scheduled run too, so that a run is never repeated
+        // when the scheduler clock expires slightly ahead of the system clock.
+        const auto system_now = _clock->system_now();
+        const auto next_run = schedule->next(tc::sdk::datetime(std::max(system_now, task_slot.calendar_timepoint)));
+        if (!next_run.has_value())
+            return std::nullopt;
+
+        task_slot.calendar_timepoint = next_run->to_time_point();
+        return now + std::chrono::duration_cast<tc::sdk::clock::duration>(task_slot.calendar_timepoint - system_now);
+    }
+
+    // Make sure that next_start_time is greater than the current time,
+    // otherwise the task is scheduled in the past.
+    // Increment next_start_time starting from current start_time with a step equal to the task interval
+    // in order to keep the scheduling with a fixed sample rate.
+    auto task_next_start_time = task_slot.timepoint + task_slot.active_interval;
+    uint64_t missed_periods = 0;
+    while (now >= task_next_start_time)
+    {
+        task_next_start_time += task_slot.active_interval;
+        ++missed_periods;
+    }
+
+    if (const auto& stats = task_slot.task->state()->stats; stats && missed_periods > 0)
+        stats->missed_periods.fetch_add(missed_periods, std::memory_order_relaxed);
+
+    return task_next_start_time;
+}
+
+auto task_scheduler::phase_offset(const schedulable_task& st, slot_index_t index, tc::sdk::clock::duration interval) const -> tc::sdk::clock::duration
+{
+    if (interval <= tc::sdk::clock::duration{0})
+        return tc::sdk::clock::duration{0};
+
+    const auto interval_count = static_cast<uint64_t>(interval.count());
+    switch (_phase_spreading.load())
+    {
+    case phase_spreading::jitter:
+    {
+        thread_local std::mt19937_64 generator{std::random_device()()};
+        return tc::sdk::clock::duration{static_cast<tc::sdk::clock::rep>(std::uniform_int_distribution<uint64_t>(0, interval_count - 1)(generator))};
+    }
+    case phase_spreading::hash:
+    {
+        const auto& task_id = st.id();
+        const uint64_t key = task_id.has_value() ? std::hash<std::string>{}(task_id.value()) : index;
+        return tc::sdk::clock::duration{static_cast<tc::sdk::clock::rep>(mix_bits(key) % interval_count)};
+    }
+    case phase_spreading::none:
+        break;
+    }
+
+    return tc::sdk::clock::duration{0};
+}
+
+auto task_scheduler::retry_delay(const retry_policy& policy, size_t attempt) const -> tc::sdk::clock::duration
+{
+    const auto max_delay = std::chrono::duration<double>(std::max(policy.max_delay, tc::sdk::clock::duration{0}));
+    auto delay = std::chrono::duration<double>(std::max(policy.initial_delay, tc::sdk::clock::duration{0}));
+    for (size_t n = 1; n < attempt && delay < max_delay; ++n)
+        delay *= policy.multiplier;
+
+    delay = std::min(delay, max_delay);
+
+    if (const auto jitter = std::clamp(policy.jitter, 0.0, 1.0); jitter > 0.0)
+    {
+        thread_local std::mt19937_64 generator{std::random_device()()};
+        delay *= 1.0 - jitter * std::uniform_real_distribution<double>(0.0, 1.0)(generator);
+    }
+
+    return std::chrono::duration_cast<tc::sdk::clock::duration>(delay);
+}
+
+bool task_scheduler::run_recursive_task(task_slot& task_slot)
+{
+    const auto& state = task_slot.task->state();
+    const auto policy = task_slot.overlap.load();
+
+    if (policy == overlap_policy::allow)
+    {
+        _tp.execute([this, s = state, timepoint = task_slot.timepoint, g = activity_guard(_dispatched_tasks_count)] { run_task(*s, timepoint); });
+        return true;
+    }
+
+    auto run_flags = state->run_flags.load();
+    while (true)
+    {
+        if (!(run_flags & run_running))
         {
-            return hash == it.second.hash().value();
+            if (state->run_flags.compare_exchange_weak(run_flags, run_running))
+            {
+                _tp.execute([this, s = state, timepoint = task_slot.timepoint, g = activity_guard(_dispatched_tasks_count)] { run_exclusive(*s, timepoint); });
+                return true;
+            }
         }
-        return false;
-    });
+        else if (policy == overlap_policy::skip)
+        {
+            ++task_slot.skipped_runs;
+            return false;
+        }
+        else if ((run_flags & run_pending) || state->run_flags.compare_exchange_weak(run_flags, run_flags | run_pending))
+        {
+            ++task_slot.coalesced_runs;
+            return false;
+        }
+    }
 }
 
-bool task_scheduler::already_exists(const std::optional<size_t>& opt_hash)
+void task_scheduler::run_task(task_state& state, std::optional<tc::sdk::clock::time_point> timepoint) const
 {
-    if (!opt_hash.has_value())
-        return false;
+    if (!state.stats)
+    {
+        state.task.invoke();
+        return;
+    }
+
+    const auto start_time = _clock->now();
+    if (timepoint.has_value())
+        state.stats->lateness.record(start_time - *timepoint);
+
+    state.task.invoke();
+    state.stats->duration.record(_clock->now() - start_time);
+}
+
+void task_scheduler::run_exclusive(task_state& state, tc::sdk::clock::time_point timepoint) const
+{
+    // Run the task again while a coalesced run is pending, otherwise clear the running flag.
+    // Both checks happen in the same CAS, so that a run coalesced by the scheduler thread is never lost.
+    // The coalesced runs have no scheduled time of their own, so their lateness is not recorded.
+    std::optional<tc::sdk::clock::time_point> run_timepoint = timepoint;
+    auto run_flags = state.run_flags.load();
+    do
+    {
+        run_task(state, run_timepoint);
+        run_timepoint.reset();
 
-    return std::any_of(_tasks.begin(), _tasks.end(), [hash = opt_hash.value()](auto&& it) {
-        if (it.second.hash().has_value())
+        run_flags = state.run_flags.load();
+        while (!state.run_flags.compare_exchange_weak(run_flags, (run_flags & run_pending) ? run_running : 0))
         {
-            return hash == it.second.hash().value();
         }
-        return false;
-    });
+    } while (run_flags & run_pending);
+}
+
+void task_scheduler::reschedule_slot(slot_index_t index, tc::sdk::clock::time_point timepoint)
+{
+    auto& task_slot = slot(index);
+    task_slot.timepoint = timepoint;
+
+    if (task_slot.is_pending)
+        _timers->update(index, expiry_time(task_slot));
+    else
+        insert_timer(index);
+}
+
+void task_scheduler::insert_timer(slot_index_t index)
+{
+    auto& task_slot = slot(index);
+    _timers->insert(index, expiry_time(task_slot));
+    task_slot.is_pending = true;
+}
+
+tc::sdk::clock::time_point task_scheduler::expiry_time(const task_slot& task_slot) const
+{
+    // Round the start time up to a multiple of the slack:
+    // all the tasks whose start times fall inside the same slack window expire at the same time, with a single wakeup.
+    const auto task_slack = task_slot.slack.load();
+    const auto slack = tc::sdk::clock::duration{task_slack == default_slack ? _timer_slack.load() : task_slack};
+    if (slack <= tc::sdk::clock::duration{0})
+        return task_slot.timepoint;
+
+    const auto remainder = task_slot.timepoint.time_since_epoch() % slack;
+    if (remainder == tc::sdk::clock::duration{0})
+        return task_slot.timepoint;
+
+    return task_slot.timepoint + (slack - remainder);
+}
+
+void task_scheduler::clear_tasks()
+{
+    // Called once the scheduler thread has been joined and the producers have completed.
+    // The slots holding a task (scheduled, or waiting to be released by the scheduler thread) are released
+    // rather than destroyed, so that the handles of the cleared tasks expire: free slots are already in the free list.
+    _submitted_slots_head = 0;
+    _timers->clear();
+
+    {
+        std::scoped_lock lock(_task_ids_mtx);
+        _task_ids.clear();
+    }
+
+    for (slot_index_t index = _slots->size(); index-- > 0;)
+    {
+        if (auto task_slot = _slots->find(index); task_slot != nullptr && task_slot->task.has_value())
+        {
+            task_slot->is_pending = false;
+            release_slot(index);
+        }
+    }
+
+    _tasks_count = 0;
 }
 
 }
@@ -0,0 +1,77 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ordered_timer_queue.hpp"
+
+namespace tc::sdk::detail
+{
+void ordered_timer_queue::insert(timer_id id, tc::sdk::clock::time_point timepoint)
+{
+    if (id >= _positions.size())
+        _positions.resize(id + 1);
+
+    if (_expired_nodes.empty())
+    {
+        _positions[id] = _timers.emplace(timepoint, id);
+        return;
+    }
+
+    auto node = std::move(_expired_nodes.back());
+    _expired_nodes.pop_back();
+    node.key() = timepoint;
+    node.mapped() = id;
+    _positions[id] = _timers.insert(std::move(node));
+}
+
+void ordered_timer_queue::erase(timer_id id)
+{
+    _timers.erase(_positions[id]);
+}
+
+void ordered_timer_queue::update(timer_id id, tc::sdk::clock::time_point timepoint)
+{
+    auto node = _timers.extract(_positions[id]);
+    node.key() = timepoint;
+    _positions[id] = _timers.insert(std::move(node));
+}
+
+void ordered_timer_queue::pop_expired(tc::sdk::clock::time_point now, std::vector<timer_id>& expired)
+{
+    // Release the nodes not reused since the previous call.
+    _expired_nodes.clear();
+
+    while (!_timers.empty() && _timers.begin()->first <= now)
+    {
+        expired.push_back(_timers.begin()->second);
+        _expired_nodes.emplace_back(_timers.extract(_timers.begin()));
+    }
+}
+
+tc::sdk::clock::time_point ordered_timer_queue::next_expiry() const
+{
+    return _timers.begin()->first;
+}
+
+size_t ordered_timer_queue::size() const
+{
+    return _timers.size();
+}
+
+void ordered_timer_queue::clear()
+{
+    _timers.clear();
+    _expired_nodes.clear();
+}
+
+}
@@ -0,0 +1,50 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "timer_queue.hpp"
+
+#include <map>
+
+namespace tc::sdk::detail
+{
+/*!
+ * \class ordered_timer_queue
+ * \brief Timer queue based on a std::multimap ordered by expiration time.
+ *
+ * Insert and erase are O(log n).
+ * The nodes of the expired timers are kept aside until the next pop_expired() call,
+ * so that recursive tasks re-inserted by the scheduler reuse them without any new allocation.
+ */
+class ordered_timer_queue : public timer_queue
+{
+public:
+    void insert(timer_id id, tc::sdk::clock::time_point timepoint) override;
+    void erase(timer_id id) override;
+    void update(timer_id id, tc::sdk::clock::time_point timepoint) override;
+    void pop_expired(tc::sdk::clock::time_point now, std::vector<timer_id>& expired) override;
+    tc::sdk::clock::time_point next_expiry() const override;
+    size_t size() const override;
+    void clear() override;
+
+private:
+    using timers_t = std::multimap<tc::sdk::clock::time_point, timer_id>;
+
+    timers_t _timers;
+    std::vector<timers_t::iterator> _positions;
+    std::vector<timers_t::node_type> _expired_nodes;
+};
+
+}
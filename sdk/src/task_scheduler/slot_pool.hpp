@@ -0,0 +1,163 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <teiacare/sdk/non_copyable.hpp>
+#include <teiacare/sdk/non_moveable.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+namespace tc::sdk::detail
+{
+/*!
+ * \class slot_pool
+ * \brief Lock-free pool of index addressed slots.
+ *
+ * Slots are allocated in chunks of doubling size (chunk N holds first_chunk_size << N slots), so that they never move once allocated
+ * and any thread can access a slot from its index. Released slots are recycled through a lock-free free list (Treiber stack),
+ * whose head holds a tag in its upper 32 bits, incremented at each update, to prevent the ABA problem.
+ *
+ * allocate() and release() can be called concurrently from any thread, but a slot must be released only once per allocation.
+ * Slot values are default constructed with their chunk and destroyed with the pool: a released slot keeps its value,
+ * which is handed as is to the next allocation of the slot.
+ */
+template <typename T>
+class slot_pool : private non_copyable, private non_moveable
+{
+public:
+    using index_t = uint32_t;
+
+    static constexpr size_t chunks_count = 26;
+    static constexpr uint64_t first_chunk_bits = 6;
+    static constexpr uint64_t first_chunk_size = uint64_t{1} << first_chunk_bits;
+    static constexpr uint64_t max_size = (first_chunk_size << chunks_count) - first_chunk_size;
+
+    slot_pool() = default;
+
+    ~slot_pool()
+    {
+        for (auto&& chunk : _chunks)
+            delete[] chunk.load();
+    }
+
+    /*!
+     * \brief Allocate a slot, recycling a released one if available
+     * \return Index of the slot, or std::nullopt if all the max_size slots are in use
+     */
+    std::optional<index_t> allocate()
+    {
+        auto head = _free_head.load();
+        while (static_cast<index_t>(head) != 0)
+        {
+            const index_t index = static_cast<index_t>(head) - 1;
+            const uint64_t next = entry_of(index).next_free.load();
+            if (_free_head.compare_exchange_weak(head, (((head >> 32) + 1) << 32) | next))
+                return index;
+        }
+
+        const auto position = _size.fetch_add(1);
+        if (position >= max_size)
+            return std::nullopt;
+
+        const auto index = static_cast<index_t>(position);
+        const auto [chunk_index, offset] = locate(index);
+        if (_chunks[chunk_index].load() == nullptr)
+        {
+            entry* expected = nullptr;
+            auto chunk = new entry[first_chunk_size << chunk_index];
+            if (!_chunks[chunk_index].compare_exchange_strong(expected, chunk))
+                delete[] chunk;
+        }
+
+        return index;
+    }
+
+    /*!
+     * \brief Give an allocated slot back to the pool
+     * \param index Index returned by allocate()
+     */
+    void release(index_t index)
+    {
+        auto& released = entry_of(index);
+        auto head = _free_head.load();
+        do
+        {
+            released.next_free.store(static_cast<index_t>(head));
+        } while (!_free_head.compare_exchange_weak(head, (((head >> 32) + 1) << 32) | (uint64_t{index} + 1)));
+    }
+
+    /*!
+     * \brief Get a slot from its index
+     * \return Pointer to the slot, or nullptr if the slot has never been allocated
+     */
+    T* find(index_t index) const
+    {
+        if (index >= size())
+            return nullptr;
+
+        const auto [chunk_index, offset] = locate(index);
+        auto chunk = _chunks[chunk_index].load();
+        return chunk != nullptr ? &chunk[offset].value : nullptr;
+    }
+
+    /*!
+     * \brief Get a slot from the index returned by allocate()
+     */
+    T& operator[](index_t index) const
+    {
+        return entry_of(index).value;
+    }
+
+    /*!
+     * \brief Number of slots allocated at least once: all the slot indices are lower than size()
+     */
+    index_t size() const
+    {
+        return static_cast<index_t>(std::min(_size.load(), max_size));
+    }
+
+private:
+    struct entry
+    {
+        T value{};
+        std::atomic<index_t> next_free{0}; // Free list link: index + 1, 0 terminates the list.
+    };
+
+    std::array<std::atomic<entry*>, chunks_count> _chunks{};
+    std::atomic<uint64_t> _size{0};
+    std::atomic<uint64_t> _free_head{0};
+
+    static std::pair<size_t, uint64_t> locate(index_t index)
+    {
+        const uint64_t position = uint64_t{index} + first_chunk_size;
+        const auto chunk_index = static_cast<size_t>(std::bit_width(position) - 1 - first_chunk_bits);
+        return {chunk_index, position - (first_chunk_size << chunk_index)};
+    }
+
+    entry& entry_of(index_t index) const
+    {
+        const auto [chunk_index, offset] = locate(index);
+        return _chunks[chunk_index].load()[offset];
+    }
+};
+
+}
@@ -0,0 +1,85 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <teiacare/sdk/clock.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace tc::sdk::detail
+{
+/*!
+ * \class timer_queue
+ * \brief Timer data structure used by tc::sdk::task_scheduler to keep track of the scheduled tasks.
+ *
+ * Timers are identified by a dense integer id (i.e. the index of the task slot in the scheduler),
+ * so that implementations can keep their bookkeeping in flat arrays.
+ * An id can be inserted at most once: it must be erased, or expired, before being inserted again.
+ * Implementations are not thread safe: the scheduler serializes all the calls.
+ */
+class timer_queue
+{
+public:
+    using timer_id = uint32_t;
+
+    virtual ~timer_queue() = default;
+
+    /*!
+     * \brief Insert a timer that expires at the given time_point.
+     */
+    virtual void insert(timer_id id, tc::sdk::clock::time_point timepoint) = 0;
+
+    /*!
+     * \brief Remove a pending timer.
+     */
+    virtual void erase(timer_id id) = 0;
+
+    /*!
+     * \brief Move a pending timer to a new expiration time, without any allocation.
+     */
+    virtual void update(timer_id id, tc::sdk::clock::time_point timepoint) = 0;
+
+    /*!
+     * \brief Remove all the timers expired at the given time_point, appending their ids to the expired vector.
+     */
+    virtual void pop_expired(tc::sdk::clock::time_point now, std::vector<timer_id>& expired) = 0;
+
+    /*!
+     * \brief Time point at which the scheduler has to call pop_expired() again.
+     *
+     * Must only be called when the queue is not empty.
+     * The returned time_point is never later than the first timer expiration, but it can be earlier
+     * (e.g. when the timing wheel needs to cascade its upper levels).
+     */
+    virtual tc::sdk::clock::time_point next_expiry() const = 0;
+
+    /*!
+     * \brief Number of pending timers.
+     */
+    virtual size_t size() const = 0;
+
+    /*!
+     * \brief Remove all the pending timers.
+     */
+    virtual void clear() = 0;
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+};
+
+}
@@ -0,0 +1,168 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "timerfd_waiter.hpp"
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <system_error>
+#endif
+
+namespace tc::sdk::detail
+{
+#if defined(__linux__)
+std::unique_ptr<timerfd_waiter> timerfd_waiter::create()
+{
+    const int epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+    const int timer_fd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    const int event_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    bool is_valid = epoll_fd >= 0 && timer_fd >= 0 && event_fd >= 0;
+    for (const int fd : {timer_fd, event_fd})
+    {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        is_valid = is_valid && ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) == 0;
+    }
+
+    if (!is_valid)
+    {
+        for (const int fd : {epoll_fd, timer_fd, event_fd})
+        {
+            if (fd >= 0)
+                ::close(fd);
+        }
+
+        return nullptr;
+    }
+
+    return std::unique_ptr<timerfd_waiter>(new timerfd_waiter(epoll_fd, timer_fd, event_fd));
+}
+
+timerfd_waiter::timerfd_waiter(int epoll_fd, int timer_fd, int event_fd)
+    : _epoll_fd{epoll_fd}
+    , _timer_fd{timer_fd}
+    , _event_fd{event_fd}
+{
+}
+
+timerfd_waiter::~timerfd_waiter()
+{
+    ::close(_event_fd);
+    ::close(_timer_fd);
+    ::close(_epoll_fd);
+}
+
+int timerfd_waiter::native_handle() const
+{
+    return _epoll_fd;
+}
+
+void timerfd_waiter::arm(tc::sdk::clock::time_point deadline)
+{
+    // A zero it_value disarms the timer: deadlines at (or before) the clock epoch are moved 1ns after it,
+    // so that they expire immediately.
+    const auto ns = std::max<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count(), 1);
+
+    itimerspec spec{};
+    spec.it_value.tv_sec = static_cast<time_t>(ns / 1'000'000'000);
+    spec.it_value.tv_nsec = static_cast<long>(ns % 1'000'000'000);
+
+    if (::timerfd_settime(_timer_fd, TFD_TIMER_ABSTIME, &spec, nullptr) != 0)
+        throw std::system_error(errno, std::generic_category(), "timerfd_settime");
+}
+
+void timerfd_waiter::disarm() noexcept
+{
+    const itimerspec spec{};
+    ::timerfd_settime(_timer_fd, 0, &spec, nullptr);
+}
+
+void timerfd_waiter::notify()
+{
+    const uint64_t value = 1;
+    [[maybe_unused]] const auto bytes = ::write(_event_fd, &value, sizeof(value));
+}
+
+void timerfd_waiter::wait()
+{
+    epoll_event events[2];
+    while (::epoll_wait(_epoll_fd, events, 2, -1) < 0)
+    {
+        if (errno != EINTR)
+            throw std::system_error(errno, std::generic_category(), "epoll_wait");
+    }
+
+    reset();
+}
+
+void timerfd_waiter::reset()
+{
+    // Both file descriptors are non blocking: reading a descriptor that is not ready fails with EAGAIN.
+    uint64_t value = 0;
+    [[maybe_unused]] const auto timer_bytes = ::read(_timer_fd, &value, sizeof(value));
+    [[maybe_unused]] const auto event_bytes = ::read(_event_fd, &value, sizeof(value));
+}
+#else
+std::unique_ptr<timerfd_waiter> timerfd_waiter::create()
+{
+    return nullptr;
+}
+
+timerfd_waiter::timerfd_waiter(int epoll_fd, int timer_fd, int event_fd)
+    : _epoll_fd{epoll_fd}
+    , _timer_fd{timer_fd}
+    , _event_fd{event_fd}
+{
+}
+
+timerfd_waiter::~timerfd_waiter()
+{
+}
+
+int timerfd_waiter::native_handle() const
+{
+    return -1;
+}
+
+void timerfd_waiter::arm(tc::sdk::clock::time_point)
+{
+}
+
+void timerfd_waiter::disarm() noexcept
+{
+}
+
+void timerfd_waiter::notify()
+{
+}
+
+void timerfd_waiter::wait()
+{
+}
+
+void timerfd_waiter::reset()
+{
+}
+#endif
+
+}
@@ -0,0 +1,84 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <teiacare/sdk/clock.hpp>
+#include <teiacare/sdk/non_copyable.hpp>
+#include <teiacare/sdk/non_moveable.hpp>
+
+#include <memory>
+
+namespace tc::sdk::detail
+{
+/*!
+ * \class timerfd_waiter
+ * \brief Wakeup source of tc::sdk::task_scheduler based on timerfd, eventfd and epoll (Linux only).
+ *
+ * The next expiration is armed on a timerfd as an absolute CLOCK_MONOTONIC deadline (the same clock as tc::sdk::clock),
+ * while new submissions are signaled through an eventfd: both are registered in an epoll instance,
+ * whose file descriptor becomes readable as soon as the scheduler has work to do.
+ * Unlike a condition variable, an eventfd keeps the notifications sent before the wait, so no lock is needed to avoid lost wakeups.
+ */
+class timerfd_waiter : private non_copyable, private non_moveable
+{
+public:
+    /*!
+     * \brief Create the file descriptors, return nullptr if they are not supported on the current platform.
+     */
+    static std::unique_ptr<timerfd_waiter> create();
+
+    ~timerfd_waiter();
+
+    /*!
+     * \brief epoll file descriptor, readable when the armed deadline expires or when notify() is called.
+     */
+    int native_handle() const;
+
+    /*!
+     * \brief Arm the timer at the given deadline.
+     * \throws std::system_error if the timer cannot be armed: the native handle would not become readable at the deadline.
+     */
+    void arm(tc::sdk::clock::time_point deadline);
+
+    /*!
+     * \brief Disarm the timer.
+     */
+    void disarm() noexcept;
+
+    /*!
+     * \brief Wake up the waiting thread (or the event loop polling the native handle).
+     */
+    void notify();
+
+    /*!
+     * \brief Wait until the armed deadline expires or notify() is called, then reset().
+     * \throws std::system_error if the wait fails for any reason other than an interruption by a signal.
+     */
+    void wait();
+
+    /*!
+     * \brief Consume the pending expiration and notifications, so that the native handle is no longer readable.
+     */
+    void reset();
+
+private:
+    timerfd_waiter(int epoll_fd, int timer_fd, int event_fd);
+
+    const int _epoll_fd;
+    const int _timer_fd;
+    const int _event_fd;
+};
+
+}
@@ -0,0 +1,216 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "timing_wheel.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace tc::sdk::detail
+{
+timing_wheel::timing_wheel(tc::sdk::clock::duration resolution, tc::sdk::clock::time_point origin)
+    : _resolution{std::max(resolution, tc::sdk::clock::duration{1})}
+    , _origin{origin}
+{
+    clear();
+}
+
+void timing_wheel::insert(timer_id id, tc::sdk::clock::time_point timepoint)
+{
+    if (id >= _entries.size())
+        _entries.resize(id + 1);
+
+    _entries[id].tick = to_tick(timepoint);
+    place(id);
+    ++_size;
+}
+
+void timing_wheel::erase(timer_id id)
+{
+    unlink(id);
+    --_size;
+}
+
+void timing_wheel::update(timer_id id, tc::sdk::clock::time_point timepoint)
+{
+    unlink(id);
+    _entries[id].tick = to_tick(timepoint);
+    place(id);
+}
+
+void timing_wheel::pop_expired(tc::sdk::clock::time_point now, std::vector<timer_id>& expired)
+{
+    if (now < _origin)
+        return;
+
+    // Round down: a tick is processed only when it is fully elapsed, so that timers never expire early.
+    const tick_t target_tick = static_cast<tick_t>((now - _origin) / _resolution);
+    while (_current_tick <= target_tick)
+    {
+        const tick_t next_tick = _size == 0 ? target_tick + 1 : next_event_tick();
+        if (next_tick > target_tick)
+        {
+            // Nothing happens up to target_tick: skip all the idle ticks at once.
+            _current_tick = target_tick + 1;
+            break;
+        }
+
+        process_tick(next_tick, expired);
+    }
+}
+
+tc::sdk::clock::time_point timing_wheel::next_expiry() const
+{
+    return _origin + _resolution * static_cast<tc::sdk::clock::rep>(next_event_tick());
+}
+
+size_t timing_wheel::size() const
+{
+    return _size;
+}
+
+void timing_wheel::clear()
+{
+    for (auto&& level : _slots)
+        level.fill(npos);
+
+    _occupied_slots.fill(0);
+    _size = 0;
+}
+
+auto timing_wheel::to_tick(tc::sdk::clock::time_point timepoint) const -> tick_t
+{
+    if (timepoint <= _origin)
+        return 0;
+
+    // Round up: a timer is never expired before its time_point.
+    const auto elapsed = (timepoint - _origin).count();
+    const auto resolution = _resolution.count();
+    return static_cast<tick_t>((elapsed + resolution - 1) / resolution);
+}
+
+auto timing_wheel::next_event_tick() const -> tick_t
+{
+    tick_t next_tick = std::numeric_limits<tick_t>::max();
+
+    // Level 0 slots hold the timers expiring within [_current_tick, _current_tick + slots_count):
+    // the first occupied slot (starting from the current one) is the next expiration.
+    if (_occupied_slots[0] != 0)
+    {
+        const auto offset = std::countr_zero(std::rotr(_occupied_slots[0], static_cast<int>(_current_tick % slots_count)));
+        next_tick = _current_tick + static_cast<tick_t>(offset);
+    }
+
+    // Upper levels slots are cascaded when the tick of their first block is processed.
+    for (size_t level = 1; level < levels_count; ++level)
+    {
+        if (_occupied_slots[level] == 0)
+            continue;
+
+        const unsigned shift = slot_bits * static_cast<unsigned>(level);
+        const tick_t first_block = (_current_tick + (tick_t{1} << shift) - 1) >> shift;
+        const auto offset = std::countr_zero(std::rotr(_occupied_slots[level], static_cast<int>(first_block % slots_count)));
+        next_tick = std::min(next_tick, (first_block + static_cast<tick_t>(offset)) << shift);
+    }
+
+    return next_tick;
+}
+
+void timing_wheel::process_tick(tick_t tick, std::vector<timer_id>& expired)
+{
+    _current_tick = tick;
+
+    // Cascade upper levels first, so that timers moved down from the top are cascaded again if needed.
+    for (size_t level = levels_count - 1; level > 0; --level)
+    {
+        const unsigned shift = slot_bits * static_cast<unsigned>(level);
+        if ((tick & ((tick_t{1} << shift) - 1)) == 0)
+            cascade(level, (tick >> shift) % slots_count);
+    }
+
+    const size_t slot = tick % slots_count;
+    for (timer_id id = _slots[0][slot]; id != npos; id = _entries[id].next)
+    {
+        expired.push_back(id);
+        --_size;
+    }
+
+    _slots[0][slot] = npos;
+    _occupied_slots[0] &= ~(uint64_t{1} << slot);
+    _current_tick = tick + 1;
+}
+
+void timing_wheel::cascade(size_t level, size_t slot)
+{
+    timer_id id = _slots[level][slot];
+    _slots[level][slot] = npos;
+    _occupied_slots[level] &= ~(uint64_t{1} << slot);
+
+    while (id != npos)
+    {
+        const timer_id next = _entries[id].next;
+        place(id);
+        id = next;
+    }
+}
+
+void timing_wheel::place(timer_id id)
+{
+    const tick_t tick = _entries[id].tick;
+    tick_t delta = tick > _current_tick ? tick - _current_tick : 0;
+
+    // Level N holds the timers expiring in [slots_count^N, slots_count^(N+1)) ticks from now.
+    size_t level = 0;
+    while (level + 1 < levels_count && delta >= (tick_t{1} << (slot_bits * (level + 1))))
+        ++level;
+
+    const tick_t max_delta = (tick_t{1} << (slot_bits * levels_count)) - 1;
+    delta = std::min(delta, max_delta);
+
+    const tick_t effective_tick = _current_tick + delta;
+    link(id, level, (effective_tick >> (slot_bits * level)) % slots_count);
+}
+
+void timing_wheel::link(timer_id id, size_t level, size_t slot)
+{
+    auto& e = _entries[id];
+    e.level = static_cast<uint8_t>(level);
+    e.slot = static_cast<uint8_t>(slot);
+    e.prev = npos;
+    e.next = _slots[level][slot];
+
+    if (e.next != npos)
+        _entries[e.next].prev = id;
+
+    _slots[level][slot] = id;
+    _occupied_slots[level] |= uint64_t{1} << slot;
+}
+
+void timing_wheel::unlink(timer_id id)
+{
+    const auto& e = _entries[id];
+
+    if (e.prev != npos)
+        _entries[e.prev].next = e.next;
+    else
+        _slots[e.level][e.slot] = e.next;
+
+    if (e.next != npos)
+        _entries[e.next].prev = e.prev;
+
+    if (_slots[e.level][e.slot] == npos)
+        _occupied_slots[e.level] &= ~(uint64_t{1} << e.slot);
+}
+
+}
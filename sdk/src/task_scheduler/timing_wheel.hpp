@@ -0,0 +1,85 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "timer_queue.hpp"
+
+#include <array>
+#include <limits>
+
+namespace tc::sdk::detail
+{
+/*!
+ * \class timing_wheel
+ * \brief Timer queue based on a hierarchical timing wheel.
+ *
+ * Time is discretized in ticks of a configurable resolution: timers never expire early,
+ * but they can expire up to one tick late.
+ * The wheel has levels_count levels of slots_count slots each: level N slots span slots_count^N ticks,
+ * so that the wheel covers slots_count^levels_count ticks (i.e. more than two years with a 1ms resolution).
+ * Farther timers are parked in the last slot of the top level and re-inserted when it is cascaded.
+ *
+ * Insert and erase are O(1) (intrusive doubly linked lists indexed by timer id, no allocations),
+ * expiration is amortized O(1) since each timer is cascaded to a lower level at most levels_count times.
+ * Empty slots are skipped using a per-level occupancy bitmap, so idle ticks have no cost.
+ */
+class timing_wheel : public timer_queue
+{
+public:
+    explicit timing_wheel(tc::sdk::clock::duration resolution, tc::sdk::clock::time_point origin = tc::sdk::clock::now());
+
+    void insert(timer_id id, tc::sdk::clock::time_point timepoint) override;
+    void erase(timer_id id) override;
+    void update(timer_id id, tc::sdk::clock::time_point timepoint) override;
+    void pop_expired(tc::sdk::clock::time_point now, std::vector<timer_id>& expired) override;
+    tc::sdk::clock::time_point next_expiry() const override;
+    size_t size() const override;
+    void clear() override;
+
+private:
+    using tick_t = uint64_t;
+
+    static constexpr unsigned slot_bits = 6;
+    static constexpr size_t slots_count = size_t{1} << slot_bits;
+    static constexpr size_t levels_count = 6;
+    static constexpr timer_id npos = std::numeric_limits<timer_id>::max();
+
+    struct entry
+    {
+        tick_t tick = 0;
+        timer_id prev = npos;
+        timer_id next = npos;
+        uint8_t level = 0;
+        uint8_t slot = 0;
+    };
+
+    const tc::sdk::clock::duration _resolution;
+    const tc::sdk::clock::time_point _origin;
+    tick_t _current_tick = 0; // Next tick to be processed: all the previous ticks have already been processed.
+    size_t _size = 0;
+    std::vector<entry> _entries;
+    std::array<std::array<timer_id, slots_count>, levels_count> _slots;
+    std::array<uint64_t, levels_count> _occupied_slots;
+
+    tick_t to_tick(tc::sdk::clock::time_point timepoint) const;
+    tick_t next_event_tick() const;
+    void process_tick(tick_t tick, std::vector<timer_id>& expired);
+    void cascade(size_t level, size_t slot);
+    void place(timer_id id);
+    void link(timer_id id, size_t level, size_t slot);
+    void unlink(timer_id id);
+};
+
+}
@@ -20,6 +20,8 @@ namespace tc::sdk
 {
 thread_pool::thread_pool()
     : _is_running{false}
+    , _task_queue_head{0}
+    , _task_queue_size{0}
 {
 }
 
@@ -57,11 +59,17 @@ bool thread_pool::stop()
 
     _is_running = false;
 
+    // The discarded tasks are destroyed once the queue lock is released:
+    // their destructors may run user code (e.g. resume a cancelled coroutine) that submits new tasks.
+    std::vector<tc::sdk::task> discarded_tasks;
     {
         std::scoped_lock lock(_task_mutex);
-        _task_queue = {};
+        discarded_tasks.reserve(_task_queue_size);
+        while (_task_queue_size > 0)
+            discarded_tasks.emplace_back(dequeue_task());
     }
 
+    discarded_tasks.clear();
     _task_cv.notify_all();
 
     for (auto&& t : _threads)
@@ -85,6 +93,12 @@ bool thread_pool::is_running() const
     return _is_running;
 }
 
+queue_stats thread_pool::stats() const
+{
+    std::scoped_lock lock(_task_mutex);
+    return _task_stats.snapshot(_task_queue_size);
+}
+
 void thread_pool::worker()
 {
     is_ready->arrive_and_wait();
@@ -93,12 +107,18 @@ void thread_pool::worker()
     {
         std::unique_lock lock(_task_mutex);
 
-        _task_cv.wait(lock, [this] { return !_task_queue.empty() || !_is_running; });
+        if (_task_queue_size == 0)
+        {
+            const auto wait_begin = _task_stats.wait_begin();
+            _task_cv.wait(lock, [this] { return _task_queue_size > 0 || !_is_running; });
+            _task_stats.on_pop_blocked(wait_begin);
+        }
+
         if (!_is_running)
             return;
 
-        auto task = std::move(_task_queue.front());
-        _task_queue.pop();
+        auto task = dequeue_task();
+        _task_stats.on_pop();
         lock.unlock();
 
         task();
@@ -109,10 +129,34 @@ void thread_pool::enqueue_task(tc::sdk::task&& task)
 {
     {
         std::scoped_lock lock(_task_mutex);
-        _task_queue.emplace(std::move(task));
+        // Grow the circular buffer when full: in steady state tasks are enqueued without any allocation.
+        if (_task_queue_size == _task_queue.size())
+        {
+            std::vector<std::optional<tc::sdk::task>> task_queue(std::max<size_t>(16, _task_queue.size() * 2));
+            for (size_t i = 0; i < _task_queue_size; ++i)
+                task_queue[i].emplace(std::move(*_task_queue[(_task_queue_head + i) % _task_queue.size()]));
+
+            _task_queue.swap(task_queue);
+            _task_queue_head = 0;
+        }
+
+        _task_queue[(_task_queue_head + _task_queue_size) % _task_queue.size()].emplace(std::move(task));
+        ++_task_queue_size;
+        _task_stats.on_push(_task_queue_size);
     }
 
     _task_cv.notify_one();
 }
 
+tc::sdk::task thread_pool::dequeue_task()
+{
+    auto& front = _task_queue[_task_queue_head];
+    tc::sdk::task task(std::move(*front));
+    front.reset();
+
+    _task_queue_head = (_task_queue_head + 1) % _task_queue.size();
+    --_task_queue_size;
+    return task;
+}
+
 }
@@ -0,0 +1,73 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <teiacare/sdk/throttler.hpp>
+
+#include <algorithm>
+
+namespace tc::sdk
+{
+throttler::throttler(tc::sdk::task_scheduler& scheduler, tc::sdk::clock::duration period, std::function<void()> callback)
+    : _scheduler{scheduler}
+    , _period{period}
+    , _state{std::make_shared<state>()}
+{
+    _state->callback = std::move(callback);
+
+    // The next run time is published before clearing the pending flag, so that the next trigger() arms the task at the end of the period.
+    _handle = _scheduler.on_demand([s = _state, clock = _scheduler.get_clock(), period] {
+        ++s->running_count;
+        if (!s->is_cancelled)
+        {
+            s->next_run_time = (clock->now() + period).time_since_epoch().count();
+            s->is_pending = false;
+            s->callback();
+        }
+
+        --s->running_count;
+        s->running_count.notify_all();
+    });
+
+    _scheduler.set_overlap_policy(_handle, tc::sdk::task_scheduler::overlap_policy::coalesce);
+}
+
+throttler::~throttler()
+{
+    _state->is_cancelled = true;
+    _scheduler.remove_task(_handle);
+
+    for (auto running_count = _state->running_count.load(); running_count != 0; running_count = _state->running_count.load())
+        _state->running_count.wait(running_count);
+}
+
+bool throttler::trigger()
+{
+    // Coalesce the event into the call already pending.
+    if (_state->is_pending.exchange(true))
+        return true;
+
+    const auto next_run_time = tc::sdk::clock::time_point{tc::sdk::clock::duration{_state->next_run_time.load()}};
+    if (_scheduler.reschedule(_handle, std::max(_scheduler.get_clock()->now(), next_run_time)))
+        return true;
+
+    _state->is_pending = false;
+    return false;
+}
+
+bool throttler::is_pending() const
+{
+    return _state->is_pending;
+}
+
+}
@@ -0,0 +1,22 @@
+namespace tc::sdk::info
+{
+extern const char* const name = "teiacare_sdk";
+extern const char* const version = "0.2.3";
+
+extern const char* const project_description = "TeiaCareSDK is a collection of reusable C++ components";
+extern const char* const project_url = "https://github.com/TeiaCare/TeiaCareSDK";
+
+extern const char* const build_type = "";
+extern const char* const compiler_name = "GNU";
+extern const char* const compiler_version = "12.2.0";
+
+extern const char* const cxx_flags = "";
+extern const char* const cxx_flags_debug = "-g";
+extern const char* const cxx_flags_release = "-O3 -DNDEBUG";
+extern const char* const cxx_standard = "20";
+
+extern const char* const os_name = "Linux";
+extern const char* const os_version = "6.18.44-fc-v139";
+extern const char* const os_processor = "x86_64";
+
+}
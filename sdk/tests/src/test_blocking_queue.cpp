@@ -15,8 +15,11 @@
 #include "test_blocking_queue.hpp"
 
 #include <gtest/gtest.h>
+#include <latch>
+#include <thread>
 
 using namespace std::string_literals;
+using namespace std::chrono_literals;
 
 namespace tc::sdk::tests
 {
@@ -224,4 +227,193 @@ TEST_P(test_blocking_queue_producer_consumer_string, test)
 {
     producer_consumer(GetParam());
 } // NOLINT
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// Select
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// NOLINTNEXTLINE
+TEST(test_blocking_queue_select, wait_any_already_ready)
+{
+    auto commands = tc::sdk::blocking_queue<int>(4);
+    auto frames = tc::sdk::blocking_queue<std::string>(4);
+
+    frames.push("frame"s);
+    EXPECT_EQ(tc::sdk::wait_any(commands, frames), 1);
+    EXPECT_EQ(frames.size(), 1);
+
+    commands.push(42);
+    EXPECT_EQ(tc::sdk::wait_any(commands, frames), 0);
+}
+
+// NOLINTNEXTLINE
+TEST(test_blocking_queue_select, wait_any_wakes_on_push)
+{
+    auto commands = tc::sdk::blocking_queue<int>(4);
+    auto frames = tc::sdk::blocking_queue<std::string>(4);
+    auto control = tc::sdk::blocking_queue<const char*>(4);
+
+    auto producer = std::thread([&] {
+        std::this_thread::sleep_for(20ms);
+        control.push("stop");
+    });
+
+    EXPECT_EQ(tc::sdk::wait_any(commands, frames, control), 2);
+    EXPECT_EQ(std::string(control.pop()), "stop"s);
+
+    producer.join();
+}
+
+// NOLINTNEXTLINE
+TEST(test_blocking_queue_select, wait_any_for_timeout)
+{
+    auto commands = tc::sdk::blocking_queue<int>(4);
+    auto frames = tc::sdk::blocking_queue<std::string>(4);
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(tc::sdk::wait_any_for(20ms, commands, frames), std::nullopt);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+
+    commands.push(1);
+    EXPECT_EQ(tc::sdk::wait_any_for(20ms, commands, frames), 0);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// Stats
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// NOLINTNEXTLINE
+TEST(test_blocking_queue_stats, counters)
+{
+    auto q = tc::sdk::blocking_queue<int>(2);
+    q.push(1);
+    q.push(2);
+    q.pop();
+    q.try_push(3);
+    q.try_push(4);
+
+    const auto stats = q.stats();
+    if constexpr (tc::sdk::queue_stats_enabled)
+    {
+        EXPECT_EQ(stats.size, 2);
+        EXPECT_EQ(stats.peak_size, 2);
+        EXPECT_EQ(stats.push_count, 3);
+        EXPECT_EQ(stats.pop_count, 1);
+    }
+    else
+    {
+        EXPECT_EQ(stats.size, 0);
+        EXPECT_EQ(stats.peak_size, 0);
+        EXPECT_EQ(stats.push_count, 0);
+        EXPECT_EQ(stats.pop_count, 0);
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(test_blocking_queue_stats, blocked_time)
+{
+    auto q = tc::sdk::blocking_queue<int>(1);
+
+    auto producer = std::thread([&] {
+        std::this_thread::sleep_for(20ms);
+        q.push(1);
+    });
+
+    EXPECT_EQ(q.pop(), 1); // blocks until the producer pushes the item
+    producer.join();
+
+    // The queue is full and the consumer pops only after a delay, so the next push blocks until then.
+    q.push(2);
+    std::latch pushing(1);
+    auto consumer = std::thread([&] {
+        pushing.wait();
+        std::this_thread::sleep_for(20ms);
+        EXPECT_EQ(q.pop(), 2);
+    });
+
+    pushing.count_down();
+    q.push(3);
+    consumer.join();
+    EXPECT_EQ(q.pop(), 3);
+
+    const auto stats = q.stats();
+    if constexpr (tc::sdk::queue_stats_enabled)
+    {
+        EXPECT_GT(stats.pop_blocked_time, 0ms);
+        EXPECT_GT(stats.push_blocked_time, 0ms);
+    }
+    else
+    {
+        EXPECT_EQ(stats.pop_blocked_time, 0ms);
+        EXPECT_EQ(stats.push_blocked_time, 0ms);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// Wakeups
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// NOLINTNEXTLINE
+TEST(test_blocking_queue_wakeup, many_waiting_consumers)
+{
+    constexpr int consumers_count = 8;
+    auto q = tc::sdk::blocking_queue<int>(1);
+    std::atomic_int consumed_items = 0;
+
+    std::vector<std::thread> consumers;
+    for (int i = 0; i < consumers_count; ++i)
+        consumers.emplace_back([&] {
+            q.pop();
+            ++consumed_items;
+        });
+
+    std::this_thread::sleep_for(10ms);
+    EXPECT_EQ(consumed_items, 0);
+
+    // Capacity is 1: each push blocks until a waiting consumer is woken up and pops the previous item.
+    for (int i = 0; i < consumers_count; ++i)
+        q.push(i);
+
+    for (auto&& c : consumers)
+        c.join();
+
+    EXPECT_EQ(consumed_items, consumers_count);
+    EXPECT_EQ(q.size(), 0);
+}
+
+// NOLINTNEXTLINE
+TEST(test_blocking_queue_wakeup, many_waiting_producers)
+{
+    constexpr int producers_count = 8;
+    auto q = tc::sdk::blocking_queue<int>(1);
+    q.push(-1);
+
+    std::vector<std::thread> producers;
+    for (int i = 0; i < producers_count; ++i)
+        producers.emplace_back([&q, i] { q.push(i); });
+
+    std::this_thread::sleep_for(10ms);
+    EXPECT_EQ(q.size(), 1);
+
+    int sum = 0;
+    for (int i = 0; i < producers_count + 1; ++i)
+        sum += q.pop();
+
+    for (auto&& p : producers)
+        p.join();
+
+    EXPECT_EQ(sum, -1 + producers_count * (producers_count - 1) / 2);
+    EXPECT_EQ(q.size(), 0);
+}
+
+// NOLINTNEXTLINE
+TEST(test_blocking_queue_wakeup, move_only_items)
+{
+    auto q = tc::sdk::blocking_queue<std::unique_ptr<int>>(2);
+    q.push(std::make_unique<int>(1));
+    EXPECT_TRUE(q.try_push(std::make_unique<int>(2)));
+
+    EXPECT_EQ(*q.pop(), 1);
+    EXPECT_EQ(*q.try_pop().value(), 2);
+}
 }
@@ -0,0 +1,143 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "test_clock_source.hpp"
+
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace tc::sdk::tests
+{
+// NOLINTNEXTLINE
+TEST(test_steady_clock_source, now)
+{
+    const auto clock = tc::sdk::clock_source::steady();
+    EXPECT_EQ(clock, tc::sdk::clock_source::steady());
+
+    const auto before = tc::sdk::clock::now();
+    const auto now = clock->now();
+    EXPECT_LE(before, now);
+    EXPECT_LE(now, tc::sdk::clock::now());
+
+    const auto system_now = clock->system_now();
+    EXPECT_LT(std::chrono::abs(std::chrono::system_clock::now() - system_now), 1s);
+}
+
+// NOLINTNEXTLINE
+TEST(test_steady_clock_source, sleep_until)
+{
+    const auto clock = tc::sdk::clock_source::steady();
+
+    const auto timepoint = clock->now() + 10ms;
+    clock->sleep_until(timepoint);
+    EXPECT_GE(clock->now(), timepoint);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_manual_clock, advance)
+{
+    EXPECT_EQ(clock->now(), tc::sdk::clock::time_point{});
+
+    clock->advance(1h);
+    EXPECT_EQ(clock->now(), tc::sdk::clock::time_point{1h});
+
+    clock->advance(-1min);
+    EXPECT_EQ(clock->now(), tc::sdk::clock::time_point{1h});
+
+    clock->advance_to(tc::sdk::clock::time_point{2h});
+    EXPECT_EQ(clock->now(), tc::sdk::clock::time_point{2h});
+
+    clock->advance_to(tc::sdk::clock::time_point{1h});
+    EXPECT_EQ(clock->now(), tc::sdk::clock::time_point{2h});
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_manual_clock, system_now)
+{
+    const auto system_start = tc::sdk::sys_time_point{std::chrono::sys_days{2024y / std::chrono::May / 1d}};
+    tc::sdk::manual_clock c(tc::sdk::clock::time_point{5h}, system_start);
+
+    EXPECT_EQ(c.now(), tc::sdk::clock::time_point{5h});
+    EXPECT_EQ(c.system_now(), system_start);
+
+    c.advance(24h);
+    EXPECT_EQ(c.system_now(), system_start + 24h);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_manual_clock, sleep_until)
+{
+    std::atomic<bool> is_awake{false};
+    std::thread sleeper([this, &is_awake] {
+        clock->sleep_until(tc::sdk::clock::time_point{10s});
+        is_awake = true;
+    });
+
+    clock->wait_for_idle();
+    EXPECT_FALSE(is_awake);
+
+    clock->advance(5s);
+    clock->wait_for_idle();
+    EXPECT_FALSE(is_awake);
+
+    clock->advance(5s);
+    sleeper.join();
+    EXPECT_TRUE(is_awake);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_manual_clock, wait_until)
+{
+    std::mutex mtx;
+    std::condition_variable cv;
+    clock->subscribe(cv, mtx);
+
+    std::atomic<int> wakeups{0};
+    std::thread waiter([this, &mtx, &cv, &wakeups] {
+        std::unique_lock lock(mtx);
+        while (clock->now() < tc::sdk::clock::time_point{1min})
+        {
+            clock->wait_until(cv, lock, tc::sdk::clock::time_point{1min});
+            ++wakeups;
+        }
+    });
+
+    // Each change of time wakes up the subscribed waiters.
+    clock->wait_for_idle();
+    for (auto n = 1; n <= 6; ++n)
+    {
+        clock->advance(10s);
+        if (n < 6)
+            clock->wait_for_idle();
+    }
+
+    waiter.join();
+    clock->unsubscribe(cv);
+    EXPECT_GE(wakeups, 6);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_manual_clock, wait_until_expired)
+{
+    std::mutex mtx;
+    std::condition_variable cv;
+    clock->advance(1min);
+
+    // Waiting for a time_point in the past returns immediately.
+    std::unique_lock lock(mtx);
+    clock->wait_until(cv, lock, tc::sdk::clock::time_point{1min});
+    clock->wait_until(cv, lock, tc::sdk::clock::time_point{});
+    SUCCEED();
+}
+}
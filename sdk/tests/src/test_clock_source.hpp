@@ -0,0 +1,37 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <teiacare/sdk/clock_source.hpp>
+
+#include <gtest/gtest.h>
+
+namespace tc::sdk::tests
+{
+class test_manual_clock : public ::testing::Test
+{
+protected:
+    explicit test_manual_clock()
+        : clock{std::make_shared<tc::sdk::manual_clock>()}
+    {
+    }
+
+    ~test_manual_clock() override
+    {
+    }
+
+    std::shared_ptr<tc::sdk::manual_clock> clock;
+};
+
+}
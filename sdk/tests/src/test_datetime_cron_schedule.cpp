@@ -0,0 +1,175 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "test_datetime_cron_schedule.hpp"
+
+namespace tc::sdk::tests
+{
+TEST_F(test_datetime_cron_schedule, from_string)
+{
+    EXPECT_NO_THROW(tc::sdk::cron_schedule::from_string("* * * * *"));
+    EXPECT_NO_THROW(tc::sdk::cron_schedule::from_string("*/10 * * * * *"));
+    EXPECT_NO_THROW(tc::sdk::cron_schedule::from_string("0 8-18/2 1,15 JAN-jun mon-FRI"));
+    EXPECT_NO_THROW(tc::sdk::cron_schedule::from_string("  5/15   0  ?  *  7  "));
+    EXPECT_NO_THROW(tc::sdk::cron_schedule::from_string("@daily"));
+
+    const auto schedule = tc::sdk::cron_schedule::from_string("0 12 * * *");
+    EXPECT_EQ(schedule.to_string(), "0 12 * * *");
+}
+
+TEST_F(test_datetime_cron_schedule, from_string_invalid)
+{
+    EXPECT_THROW(tc::sdk::cron_schedule::from_string(""), std::runtime_error);
+    EXPECT_THROW(tc::sdk::cron_schedule::from_string("* * * *"), std::runtime_error);
+    EXPECT_THROW(tc::sdk::cron_schedule::from_string("* * * * * * *"), std::runtime_error);
+    EXPECT_THROW(tc::sdk::cron_schedule::from_string("60 * * * *"), std::runtime_error);
+    EXPECT_THROW(tc::sdk::cron_schedule::from_string("* 24 * * *"), std::runtime_error);
+    EXPECT_THROW(tc::sdk::cron_schedule::from_string("* * 0 * *"), std::runtime_error);
+    EXPECT_THROW(tc::sdk::cron_schedule::from_string("* * * 13 *"), std::runtime_error);
+    EXPECT_THROW(tc::sdk::cron_schedule::from_string("* * * * 8"), std::runtime_error);
+    EXPECT_THROW(tc::sdk::cron_schedule::from_string("*/0 * * * *"), std::runtime_error);
+    EXPECT_THROW(tc::sdk::cron_schedule::from_string("10-5 * * * *"), std::runtime_error);
+    EXPECT_THROW(tc::sdk::cron_schedule::from_string("1,,2 * * * *"), std::runtime_error);
+    EXPECT_THROW(tc::sdk::cron_schedule::from_string("* * * FOO *"), std::runtime_error);
+    EXPECT_THROW(tc::sdk::cron_schedule::from_string("JAN * * * *"), std::runtime_error);
+    EXPECT_THROW(tc::sdk::cron_schedule::from_string("@often"), std::runtime_error);
+}
+
+TEST_F(test_datetime_cron_schedule, next_every_second)
+{
+    const auto schedule = tc::sdk::cron_schedule::from_string("* * * * * *");
+
+    EXPECT_EQ(schedule.next(make_datetime(2024, 5, 1, 10, 30, 15)), make_datetime(2024, 5, 1, 10, 30, 16));
+    EXPECT_EQ(schedule.next(make_datetime(2024, 5, 1, 10, 30, 15) + tc::sdk::timedelta(999ms)), make_datetime(2024, 5, 1, 10, 30, 16));
+    EXPECT_EQ(schedule.next(make_datetime(2024, 12, 31, 23, 59, 59)), make_datetime(2025, 1, 1, 0, 0, 0));
+}
+
+TEST_F(test_datetime_cron_schedule, next_is_strictly_after)
+{
+    const auto schedule = tc::sdk::cron_schedule::from_string("30 9 * * *");
+
+    EXPECT_EQ(schedule.next(make_datetime(2024, 5, 1, 9, 29, 59)), make_datetime(2024, 5, 1, 9, 30, 0));
+    EXPECT_EQ(schedule.next(make_datetime(2024, 5, 1, 9, 30, 0)), make_datetime(2024, 5, 2, 9, 30, 0));
+    EXPECT_EQ(schedule.next(make_datetime(2024, 5, 31, 10, 0, 0)), make_datetime(2024, 6, 1, 9, 30, 0));
+}
+
+TEST_F(test_datetime_cron_schedule, next_ranges_and_steps)
+{
+    const auto schedule = tc::sdk::cron_schedule::from_string("*/20 8-10 * * *");
+
+    EXPECT_EQ(schedule.next(make_datetime(2024, 5, 1, 0, 0, 0)), make_datetime(2024, 5, 1, 8, 0, 0));
+    EXPECT_EQ(schedule.next(make_datetime(2024, 5, 1, 8, 0, 0)), make_datetime(2024, 5, 1, 8, 20, 0));
+    EXPECT_EQ(schedule.next(make_datetime(2024, 5, 1, 8, 45, 0)), make_datetime(2024, 5, 1, 9, 0, 0));
+    EXPECT_EQ(schedule.next(make_datetime(2024, 5, 1, 10, 40, 0)), make_datetime(2024, 5, 2, 8, 0, 0));
+
+    const auto start_with_step = tc::sdk::cron_schedule::from_string("5/15 * * * *");
+    EXPECT_EQ(start_with_step.next(make_datetime(2024, 5, 1, 8, 0, 0)), make_datetime(2024, 5, 1, 8, 5, 0));
+    EXPECT_EQ(start_with_step.next(make_datetime(2024, 5, 1, 8, 50, 0)), make_datetime(2024, 5, 1, 9, 5, 0));
+}
+
+TEST_F(test_datetime_cron_schedule, next_names)
+{
+    // 2024-05-01 is a Wednesday.
+    const auto schedule = tc::sdk::cron_schedule::from_string("0 0 * feb sat,SUN");
+
+    EXPECT_EQ(schedule.next(make_datetime(2024, 5, 1)), make_datetime(2025, 2, 1));
+    EXPECT_EQ(schedule.next(make_datetime(2025, 2, 1)), make_datetime(2025, 2, 2));
+    EXPECT_EQ(schedule.next(make_datetime(2025, 2, 2)), make_datetime(2025, 2, 8));
+}
+
+TEST_F(test_datetime_cron_schedule, next_day_of_week)
+{
+    // Sunday as 0 and 7.
+    const auto sunday = tc::sdk::cron_schedule::from_string("0 0 * * 0");
+    const auto sunday_7 = tc::sdk::cron_schedule::from_string("0 0 * * 7");
+
+    EXPECT_EQ(sunday.next(make_datetime(2024, 5, 1)), make_datetime(2024, 5, 5));
+    EXPECT_EQ(sunday_7.next(make_datetime(2024, 5, 1)), make_datetime(2024, 5, 5));
+    EXPECT_EQ(sunday.next(make_datetime(2024, 5, 5)), make_datetime(2024, 5, 12));
+}
+
+TEST_F(test_datetime_cron_schedule, next_day_of_month_or_day_of_week)
+{
+    // Both restricted: either the 15th or any Monday.
+    const auto either = tc::sdk::cron_schedule::from_string("0 0 15 * MON");
+    EXPECT_EQ(either.next(make_datetime(2024, 5, 1)), make_datetime(2024, 5, 6));
+    EXPECT_EQ(either.next(make_datetime(2024, 5, 13)), make_datetime(2024, 5, 15));
+
+    // A wildcard day of month with a step is not a restriction: both fields must match.
+    const auto both = tc::sdk::cron_schedule::from_string("0 0 */2 * MON");
+    EXPECT_EQ(both.next(make_datetime(2024, 5, 1)), make_datetime(2024, 5, 13));
+}
+
+TEST_F(test_datetime_cron_schedule, next_leap_year)
+{
+    const auto schedule = tc::sdk::cron_schedule::from_string("0 12 29 2 *");
+
+    EXPECT_EQ(schedule.next(make_datetime(2024, 5, 1)), make_datetime(2028, 2, 29, 12));
+    EXPECT_EQ(schedule.next(make_datetime(2096, 3, 1)), make_datetime(2104, 2, 29, 12));
+}
+
+TEST_F(test_datetime_cron_schedule, next_never_matching)
+{
+    EXPECT_FALSE(tc::sdk::cron_schedule::from_string("0 0 30 2 *").next(make_datetime(2024, 5, 1)).has_value());
+    EXPECT_FALSE(tc::sdk::cron_schedule::from_string("0 0 31 4,6,9,11 *").next(make_datetime(2024, 5, 1)).has_value());
+}
+
+TEST_F(test_datetime_cron_schedule, next_macros)
+{
+    const auto start = make_datetime(2024, 5, 1, 10, 30);
+
+    EXPECT_EQ(tc::sdk::cron_schedule::from_string("@yearly").next(start), make_datetime(2025, 1, 1));
+    EXPECT_EQ(tc::sdk::cron_schedule::from_string("@annually").next(start), make_datetime(2025, 1, 1));
+    EXPECT_EQ(tc::sdk::cron_schedule::from_string("@monthly").next(start), make_datetime(2024, 6, 1));
+    EXPECT_EQ(tc::sdk::cron_schedule::from_string("@weekly").next(start), make_datetime(2024, 5, 5));
+    EXPECT_EQ(tc::sdk::cron_schedule::from_string("@daily").next(start), make_datetime(2024, 5, 2));
+    EXPECT_EQ(tc::sdk::cron_schedule::from_string("@midnight").next(start), make_datetime(2024, 5, 2));
+    EXPECT_EQ(tc::sdk::cron_schedule::from_string("@hourly").next(start), make_datetime(2024, 5, 1, 11));
+}
+
+TEST_F(test_datetime_cron_schedule, matches)
+{
+    const auto schedule = tc::sdk::cron_schedule::from_string("30 0 9 * * MON-FRI");
+
+    EXPECT_TRUE(schedule.matches(make_datetime(2024, 5, 1, 9, 0, 30)));
+    EXPECT_TRUE(schedule.matches(make_datetime(2024, 5, 1, 9, 0, 30) + tc::sdk::timedelta(500ms)));
+    EXPECT_FALSE(schedule.matches(make_datetime(2024, 5, 1, 9, 0, 31)));
+    EXPECT_FALSE(schedule.matches(make_datetime(2024, 5, 4, 9, 0, 30)));
+}
+
+TEST_F(test_datetime_cron_schedule, next_matches_scan)
+{
+    // Compare the incremental search against a minute by minute scan.
+    for (const auto expression : {"*/7 */5 * * *", "0 0 1,31 * *", "15 3 * * 1-5", "0 */6 13 * FRI", "59 23 28-31 2,3 *"})
+    {
+        const auto schedule = tc::sdk::cron_schedule::from_string(expression);
+
+        auto scan = make_datetime(2023, 12, 25);
+        auto next = schedule.next(scan);
+        for (int i = 0; i < 20; ++i)
+        {
+            ASSERT_TRUE(next.has_value()) << expression;
+            EXPECT_TRUE(schedule.matches(*next)) << expression;
+
+            do
+            {
+                scan = scan + tc::sdk::timedelta(1min);
+            } while (!schedule.matches(scan));
+
+            EXPECT_EQ(*next, scan) << expression;
+            next = schedule.next(*next);
+        }
+    }
+}
+
+}
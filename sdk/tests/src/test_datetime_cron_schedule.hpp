@@ -0,0 +1,41 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <teiacare/sdk/datetime/cron_schedule.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+namespace tc::sdk::tests
+{
+class test_datetime_cron_schedule : public ::testing::Test
+{
+protected:
+    explicit test_datetime_cron_schedule()
+    {
+    }
+
+    ~test_datetime_cron_schedule() override
+    {
+    }
+
+    static tc::sdk::datetime make_datetime(int y, unsigned m, unsigned d, int hh = 0, int mm = 0, int ss = 0)
+    {
+        return tc::sdk::datetime(std::chrono::year(y), std::chrono::month(m), std::chrono::day(d), std::chrono::hours(hh), std::chrono::minutes(mm), std::chrono::seconds(ss));
+    }
+};
+
+}
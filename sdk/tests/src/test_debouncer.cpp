@@ -0,0 +1,135 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "test_debouncer.hpp"
+
+#include <atomic>
+
+namespace tc::sdk::tests
+{
+// NOLINTNEXTLINE
+TEST_F(test_debouncer, scheduler_not_running)
+{
+    tc::sdk::task_scheduler stopped_ts;
+    tc::sdk::debouncer debouncer(stopped_ts, 100ms, [] {});
+
+    EXPECT_FALSE(debouncer.trigger());
+    EXPECT_FALSE(debouncer.is_pending());
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_debouncer, burst)
+{
+    std::atomic<int> calls{0};
+    tc::sdk::debouncer debouncer(ts, 100ms, [&calls] { ++calls; });
+
+    // Each event restarts the delay: the callback is not run while the burst goes on.
+    for (auto n = 0; n < 10; ++n)
+    {
+        EXPECT_TRUE(debouncer.trigger());
+        clock->advance(50ms);
+        clock->wait_for_idle();
+    }
+
+    EXPECT_TRUE(debouncer.is_pending());
+    EXPECT_EQ(calls, 0);
+
+    clock->advance(50ms);
+    EXPECT_TRUE(eventually([&calls] { return calls == 1; }));
+    EXPECT_FALSE(debouncer.is_pending());
+
+    clock->advance(1h);
+    clock->wait_for_idle();
+    std::this_thread::sleep_for(10ms);
+    EXPECT_EQ(calls, 1);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_debouncer, multiple_bursts)
+{
+    std::atomic<int> calls{0};
+    tc::sdk::debouncer debouncer(ts, 100ms, [&calls] { ++calls; });
+
+    for (auto burst = 1; burst <= 3; ++burst)
+    {
+        for (auto n = 0; n < 5; ++n)
+            EXPECT_TRUE(debouncer.trigger());
+
+        clock->advance(100ms);
+        EXPECT_TRUE(eventually([&calls, burst] { return calls == burst; }));
+    }
+
+    EXPECT_EQ(calls, 3);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_debouncer, cancel)
+{
+    std::atomic<int> calls{0};
+    tc::sdk::debouncer debouncer(ts, 100ms, [&calls] { ++calls; });
+
+    EXPECT_FALSE(debouncer.cancel());
+    EXPECT_TRUE(debouncer.trigger());
+    EXPECT_TRUE(debouncer.cancel());
+    EXPECT_FALSE(debouncer.is_pending());
+
+    clock->advance(1s);
+    clock->wait_for_idle();
+    std::this_thread::sleep_for(10ms);
+    EXPECT_EQ(calls, 0);
+
+    // The debouncer can be triggered again after a cancellation.
+    EXPECT_TRUE(debouncer.trigger());
+    clock->advance(100ms);
+    EXPECT_TRUE(eventually([&calls] { return calls == 1; }));
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_debouncer, destroy_pending)
+{
+    std::atomic<int> calls{0};
+    {
+        tc::sdk::debouncer debouncer(ts, 100ms, [&calls] { ++calls; });
+        EXPECT_TRUE(debouncer.trigger());
+        EXPECT_EQ(ts.tasks_size(), 1);
+    }
+
+    clock->advance(1s);
+    clock->wait_for_idle();
+    std::this_thread::sleep_for(10ms);
+    EXPECT_EQ(calls, 0);
+    EXPECT_EQ(ts.tasks_size(), 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_debouncer, destroy_running)
+{
+    std::atomic<bool> is_running{false};
+    std::atomic<bool> is_completed{false};
+    auto debouncer = std::make_unique<tc::sdk::debouncer>(ts, 100ms, [&is_running, &is_completed] {
+        is_running = true;
+        std::this_thread::sleep_for(50ms);
+        is_completed = true;
+    });
+
+    EXPECT_TRUE(debouncer->trigger());
+    clock->advance(100ms);
+    ASSERT_TRUE(eventually([&is_running] { return is_running.load(); }));
+
+    // The destructor waits for the running callback.
+    debouncer.reset();
+    EXPECT_TRUE(is_completed);
+}
+
+}
@@ -14,11 +14,17 @@
 
 #include "test_event_dispatcher.hpp"
 
+#include <atomic>
 #include <barrier>
 #include <chrono>
 #include <future>
 #include <latch>
+#include <mutex>
 #include <semaphore>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace tc::sdk::tests
 {
@@ -593,4 +599,635 @@ TEST_F(test_event_dispatcher, DISABLED_TSAN_WARNING_push_after_remove_event_with
     EXPECT_EQ(call_count, 4);
 }
 
+// NOLINTNEXTLINE
+TEST_F(test_event_dispatcher, channel_invalid)
+{
+    tc::sdk::event_dispatcher::event_channel<int> channel;
+
+    EXPECT_FALSE(channel.is_valid());
+    EXPECT_EQ(channel.add_handler([](int) {}), 0);
+    EXPECT_FALSE(channel.emit(1));
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_event_dispatcher, channel_without_handlers)
+{
+    e->start();
+
+    auto channel = e->channel<int>("EVENT_NAME");
+    EXPECT_TRUE(channel.is_valid());
+    EXPECT_FALSE(channel.emit(1));
+    EXPECT_FALSE(e->emit("EVENT_NAME", 1));
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_event_dispatcher, channel_emit)
+{
+    e->start();
+    const auto event_name = "EVENT_NAME";
+
+    std::promise<std::string> promise;
+    std::future<std::string> future = promise.get_future();
+    e->add_handler<std::string, int>(event_name, [&promise](const std::string& s, int i) { promise.set_value(s + std::to_string(i)); });
+
+    auto channel = e->channel<std::string, int>(event_name);
+    EXPECT_TRUE(channel.emit("payload_", 1));
+    EXPECT_EQ(future.get(), "payload_1");
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_event_dispatcher, channel_add_handler)
+{
+    e->start();
+    const auto event_name = "EVENT_NAME";
+
+    auto channel = e->channel<const std::string&>(event_name);
+
+    std::promise<std::string> promise;
+    std::future<std::string> future = promise.get_future();
+    const auto handler_id = channel.add_handler([&promise](const std::string& s) { promise.set_value(s); });
+    EXPECT_NE(handler_id, 0);
+
+    // Channels and name based APIs share the same handlers.
+    EXPECT_TRUE(e->emit(event_name, std::string("payload")));
+    EXPECT_EQ(future.get(), "payload");
+
+    EXPECT_TRUE(e->remove_handler(handler_id));
+    EXPECT_FALSE(channel.emit("payload"));
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_event_dispatcher, channel_arguments_order)
+{
+    e->start();
+    const auto event_name = "EVENT_NAME";
+
+    std::promise<void> promise;
+    std::future<void> future = promise.get_future();
+    e->add_handler<int, double>(event_name, [&promise](int, double) { promise.set_value(); });
+
+    // The same argument types in a different order identify a different event.
+    EXPECT_FALSE((e->channel<double, int>(event_name).emit(1.0, 1)));
+    EXPECT_FALSE(e->emit(event_name, 1.0, 1));
+
+    EXPECT_TRUE((e->channel<int, double>(event_name).emit(1, 1.0)));
+    future.wait();
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_event_dispatcher, channel_after_remove_event)
+{
+    const auto event_name = "EVENT_NAME";
+    auto channel = e->channel<int>(event_name);
+
+    std::atomic<int> channel_calls{0};
+    std::atomic<int> name_calls{0};
+    const auto sync = tc::sdk::event_dispatcher::handler_options{tc::sdk::event_dispatcher::delivery_mode::synchronous};
+
+    channel.add_handler([](int) {}, sync);
+    EXPECT_TRUE(e->remove_event(event_name));
+    EXPECT_FALSE(channel.emit(1));
+    EXPECT_FALSE(e->emit(event_name, 1));
+
+    // The channel keeps its (removed) event alive, detached from the event name.
+    channel.add_handler([&channel_calls](int i) { channel_calls += i; }, sync);
+    EXPECT_TRUE(channel.emit(1));
+    EXPECT_FALSE(e->emit(event_name, 1));
+
+    // Handlers added by name belong to a new event, bound by the new channels.
+    e->add_handler<int>(event_name, [&name_calls](int i) { name_calls += i; }, sync);
+    EXPECT_TRUE(e->emit(event_name, 10));
+    EXPECT_TRUE(e->channel<int>(event_name).emit(100));
+    EXPECT_TRUE(channel.emit(1));
+
+    EXPECT_EQ(channel_calls, 2);
+    EXPECT_EQ(name_calls, 110);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_event_dispatcher, channel_after_stop)
+{
+    e->start();
+    auto channel = e->channel<int>("EVENT_NAME");
+    channel.add_handler([](int) {});
+
+    EXPECT_TRUE(e->stop());
+    EXPECT_FALSE(channel.emit(1));
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_event_dispatcher, update_handlers_while_emitting)
+{
+    e->start();
+    const auto event_name = "EVENT_NAME";
+    auto channel = e->channel<int>(event_name);
+
+    std::atomic<int> call_count{0};
+    std::atomic<bool> is_emitting{true};
+    std::thread emitter([&channel, &is_emitting] {
+        while (is_emitting)
+            channel.emit(1);
+    });
+
+    // Handlers are added and removed while the emitter keeps loading the handlers snapshots.
+    constexpr int handlers_count = 1000;
+    for (int n = 0; n < handlers_count; ++n)
+    {
+        const auto handler_id = e->add_handler<int>(event_name, [&call_count](int i) { call_count += i; });
+        if (n % 2 == 0)
+        {
+            EXPECT_TRUE(e->remove_handler(handler_id));
+        }
+    }
+
+    is_emitting = false;
+    emitter.join();
+
+    const auto calls_before_emit = call_count.load();
+    std::promise<void> promise;
+    std::future<void> future = promise.get_future();
+    e->add_handler<int>(event_name, [&promise](int) { promise.set_value(); });
+
+    EXPECT_TRUE(channel.emit(1));
+    future.wait();
+
+    // The handlers reference local variables: do not leave any call queued.
+    EXPECT_TRUE(e->stop());
+    EXPECT_GE(call_count, calls_before_emit + handlers_count / 2);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_event_dispatcher, removed_handler_is_destroyed)
+{
+    const auto event_name = "EVENT_NAME";
+    auto token = std::make_shared<int>(0);
+
+    const auto handler_id = e->add_handler<int>(event_name, [token](int) {});
+    e->add_handler<int>(event_name, [](int) {});
+    EXPECT_EQ(token.use_count(), 2);
+
+    // The replaced handlers snapshots are not kept alive once no emit is reading them.
+    EXPECT_TRUE(e->remove_handler(handler_id));
+    EXPECT_EQ(token.use_count(), 1);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_event_dispatcher, removed_handler_is_destroyed_while_emitting)
+{
+    auto channel = e->channel<int>("EVENT_NAME");
+    auto token = std::make_shared<int>(0);
+    const std::weak_ptr<int> weak_token = token;
+
+    std::atomic<int> emit_count{0};
+    channel.add_handler([&emit_count](int) { ++emit_count; }, {tc::sdk::event_dispatcher::delivery_mode::synchronous});
+    const auto handler_id = channel.add_handler([token = std::move(token)](int) {}, {tc::sdk::event_dispatcher::delivery_mode::synchronous});
+
+    // Several threads keep emitting, so that at any time some emit is running.
+    std::atomic<bool> is_emitting{true};
+    std::vector<std::thread> emitters;
+    for (int n = 0; n < 4; ++n)
+    {
+        emitters.emplace_back([&channel, &is_emitting] {
+            while (is_emitting)
+                channel.emit(1);
+        });
+    }
+
+    while (emit_count < 100)
+        std::this_thread::yield();
+
+    // The emits keep going, and no other handler update happens: the replaced snapshot is destroyed by the emits themselves.
+    EXPECT_TRUE(e->remove_handler(handler_id));
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!weak_token.expired() && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    EXPECT_TRUE(weak_token.expired());
+
+    is_emitting = false;
+    for (auto&& emitter : emitters)
+        emitter.join();
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_event_dispatcher, removed_handler_still_queued)
+{
+    e->start();
+    auto channel = e->channel<int>("EVENT_NAME");
+
+    // The first handler keeps the thread pool busy, so that the second one is still queued when it is removed.
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::promise<int> promise;
+    channel.add_handler([released](int) { released.wait(); });
+    const auto handler_id = channel.add_handler([&promise](int i) { promise.set_value(i); });
+
+    EXPECT_TRUE(channel.emit(42));
+    EXPECT_TRUE(e->remove_handler(handler_id));
+
+    // The emit pinned the handlers snapshot: the removed handler is still run.
+    release.set_value();
+    auto future = promise.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(future.get(), 42);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_event_dispatcher, add_events_while_emitting)
+{
+    const auto event_name = "EVENT_NAME";
+    std::atomic<int> emit_count{0};
+    e->add_handler<int>(event_name, [&emit_count](int) { ++emit_count; }, {tc::sdk::event_dispatcher::delivery_mode::synchronous});
+
+    std::atomic<bool> is_emitting{true};
+    std::thread emitter([this, event_name, &is_emitting] {
+        while (is_emitting)
+            e->emit(event_name, 1);
+    });
+
+    // Each new event publishes a new events map while the emitter keeps looking up the event by name.
+    constexpr int events_count = 1000;
+    for (int n = 0; n < events_count; ++n)
+        e->add_handler<int>("EVENT_" + std::to_string(n), [](int) {});
+
+    is_emitting = false;
+    emitter.join();
+
+    const auto emits_before = emit_count.load();
+    EXPECT_TRUE(e->emit(event_name, 1));
+    EXPECT_EQ(emit_count, emits_before + 1);
+    EXPECT_TRUE(e->emit("EVENT_" + std::to_string(events_count - 1), 1));
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_event_dispatcher, synchronous_handler)
+{
+    e->start();
+    const auto event_name = "EVENT_NAME";
+
+    int value = 0;
+    std::thread::id thread_id;
+    e->add_handler<int>(
+        event_name,
+        [&value, &thread_id](int i) {
+            value = i;
+            thread_id = std::this_thread::get_id();
+        },
+        {tc::sdk::event_dispatcher::delivery_mode::synchronous});
+
+    // The handler has already been run when emit() returns.
+    EXPECT_TRUE(e->emit(event_name, 42));
+    EXPECT_EQ(value, 42);
+    EXPECT_EQ(thread_id, std::this_thread::get_id());
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_event_dispatcher, synchronous_handler_before_start)
+{
+    auto channel = e->channel<int>("EVENT_NAME");
+
+    int value = 0;
+    channel.add_handler([&value](int i) { value = i; }, {tc::sdk::event_dispatcher::delivery_mode::synchronous});
+
+    EXPECT_TRUE(channel.emit(42));
+    EXPECT_EQ(value, 42);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_event_dispatcher, synchronous_handler_exception)
+{
+    e->start();
+    const auto event_name = "EVENT_NAME";
+
+    int call_count = 0;
+    e->add_handler(event_name, []() { throw std::runtime_error("handler failure"); }, {tc::sdk::event_dispatcher::delivery_mode::synchronous});
+    e->add_handler(event_name, [&call_count]() { ++call_count; }, {tc::sdk::event_dispatcher::delivery_mode::synchronous});
+
+    EXPECT_TRUE(e->emit(event_name));
+    EXPECT_EQ(call_count, 1);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_event_dispatcher, mixed_delivery_modes)
+{
+    e->start();
+    const auto event_name = "EVENT_NAME";
+
+    std::atomic<int> synchronous_value = 0;
+    e->add_handler<int>(event_name, [&synchronous_value](int i) { synchronous_value = i; }, {tc::sdk::event_dispatcher::delivery_mode::synchronous});
+
+    std::promise<std::thread::id> promise;
+    std::future<std::thread::id> future = promise.get_future();
+    e->add_handler<int>(event_name, [&promise](int) { promise.set_value(std::this_thread::get_id()); });
+
+    EXPECT_TRUE(e->emit(event_name, 42));
+    EXPECT_EQ(synchronous_value, 42);
+    EXPECT_NE(future.get(), std::this_thread::get_id());
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_event_dispatcher, hybrid_threshold)
+{
+    EXPECT_EQ(e->get_hybrid_threshold(), std::chrono::microseconds(10));
+
+    e->set_hybrid_threshold(std::chrono::milliseconds(1));
+    EXPECT_EQ(e->get_hybrid_threshold(), std::chrono::milliseconds(1));
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_event_dispatcher, hybrid_handler_cost_hint)
+{
+    e->start();
+    using delivery_mode = tc::sdk::event_dispatcher::delivery_mode;
+
+    // A cheap handler is run inline, an expensive one on the thread pool.
+    std::thread::id cheap_thread_id;
+    e->add_handler("CHEAP", [&cheap_thread_id]() { cheap_thread_id = std::this_thread::get_id(); }, {delivery_mode::hybrid, std::chrono::microseconds(1)});
+
+    std::promise<std::thread::id> promise;
+    std::future<std::thread::id> future = promise.get_future();
+    e->add_handler("EXPENSIVE", [&promise]() { promise.set_value(std::this_thread::get_id()); }, {delivery_mode::hybrid, std::chrono::seconds(1)});
+
+    EXPECT_TRUE(e->emit("CHEAP"));
+    EXPECT_EQ(cheap_thread_id, std::this_thread::get_id());
+
+    EXPECT_TRUE(e->emit("EXPENSIVE"));
+    EXPECT_NE(future.get(), std::this_thread::get_id());
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_event_dispatcher, hybrid_handler_measured_cost)
+{
+    e->start();
+    const auto event_name = "EVENT_NAME";
+
+    std::mutex thread_ids_mutex;
+    std::vector<std::thread::id> thread_ids;
+    std::latch sync(2);
+    e->add_handler(
+        event_name,
+        [&thread_ids_mutex, &thread_ids, &sync]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+            std::scoped_lock lock(thread_ids_mutex);
+            thread_ids.push_back(std::this_thread::get_id());
+            sync.count_down();
+        },
+        {tc::sdk::event_dispatcher::delivery_mode::hybrid});
+
+    // The first run is inline, as the handler has no cost hint: then the handler is found to be slow and moved to the thread pool.
+    EXPECT_TRUE(e->emit(event_name));
+    EXPECT_TRUE(e->emit(event_name));
+    sync.wait();
+
+    std::scoped_lock lock(thread_ids_mutex);
+    ASSERT_EQ(thread_ids.size(), 2);
+    EXPECT_EQ(thread_ids[0], std::this_thread::get_id());
+    EXPECT_NE(thread_ids[1], std::this_thread::get_id());
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_event_dispatcher, shared_payload_copied_once)
+{
+    e->start();
+    const auto event_name = "EVENT_NAME";
+    constexpr int queued_handlers = 8;
+
+    std::latch sync(queued_handlers);
+    std::mutex payloads_mutex;
+    std::vector<const copy_counted_payload*> payloads;
+    for (int i = 0; i < queued_handlers; ++i)
+    {
+        e->add_handler<copy_counted_payload>(event_name, [&sync, &payloads_mutex, &payloads](const copy_counted_payload& p) {
+            std::scoped_lock lock(payloads_mutex);
+            payloads.push_back(&p);
+            sync.count_down();
+        });
+    }
+
+    std::atomic<int> synchronous_value = 0;
+    e->add_handler<copy_counted_payload>(event_name, [&synchronous_value](const copy_counted_payload& p) { synchronous_value = p.value; }, {tc::sdk::event_dispatcher::delivery_mode::synchronous});
+
+    std::atomic<int> copies = 0;
+    const copy_counted_payload payload(copies, 42);
+    EXPECT_TRUE(e->emit(event_name, payload));
+    sync.wait();
+
+    // A single copy, made when the lvalue is passed to emit: every handler reads the same payload.
+    EXPECT_EQ(copies, 1);
+    EXPECT_EQ(synchronous_value, 42);
+
+    std::scoped_lock lock(payloads_mutex);
+    ASSERT_EQ(payloads.size(), queued_handlers);
+    for (auto&& p : payloads)
+        EXPECT_EQ(p, payloads.front());
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_event_dispatcher, shared_payload_moved)
+{
+    e->start();
+
+    std::latch sync(4);
+    std::atomic<int> value_sum = 0;
+    auto channel = e->channel<copy_counted_payload>("EVENT_NAME");
+    for (int i = 0; i < 4; ++i)
+    {
+        channel.add_handler([&sync, &value_sum](const copy_counted_payload& p) {
+            value_sum += p.value;
+            sync.count_down();
+        });
+    }
+
+    std::atomic<int> copies = 0;
+    EXPECT_TRUE(channel.emit(copy_counted_payload(copies, 10)));
+    sync.wait();
+
+    EXPECT_EQ(copies, 0);
+    EXPECT_EQ(value_sum, 40);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_event_dispatcher, shared_payload_non_const_reference_handler)
+{
+    const auto event_name = "EVENT_NAME";
+    const tc::sdk::event_dispatcher::handler_options synchronous{tc::sdk::event_dispatcher::delivery_mode::synchronous};
+
+    // A handler that can modify its argument gets a private copy, so that the other handlers are not affected.
+    e->add_handler<copy_counted_payload&>(event_name, [](copy_counted_payload& p) { p.value = -1; }, synchronous);
+
+    int value = 0;
+    e->add_handler<const copy_counted_payload&>(event_name, [&value](const copy_counted_payload& p) { value = p.value; }, synchronous);
+
+    std::atomic<int> copies = 0;
+    EXPECT_TRUE(e->emit(event_name, copy_counted_payload(copies, 7)));
+    EXPECT_EQ(copies, 1);
+    EXPECT_EQ(value, 7);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_event_dispatcher, by_value_handler_moved)
+{
+    e->start();
+    const auto event_name = "EVENT_NAME";
+
+    // A single handler taking the payload by value is its last reader: the payload is moved into its argument.
+    std::promise<int> promise;
+    e->add_handler<copy_counted_payload>(event_name, [&promise](copy_counted_payload p) { promise.set_value(p.value); });
+
+    std::atomic<int> copies = 0;
+    EXPECT_TRUE(e->emit(event_name, copy_counted_payload(copies, 3)));
+    EXPECT_EQ(promise.get_future().get(), 3);
+    EXPECT_EQ(copies, 0);
+
+    int synchronous_value = 0;
+    auto channel = e->channel<copy_counted_payload>("SYNCHRONOUS_EVENT_NAME");
+    channel.add_handler([&synchronous_value](copy_counted_payload p) { synchronous_value = p.value; }, {tc::sdk::event_dispatcher::delivery_mode::synchronous});
+
+    EXPECT_TRUE(channel.emit(copy_counted_payload(copies, 5)));
+    EXPECT_EQ(synchronous_value, 5);
+    EXPECT_EQ(copies, 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_event_dispatcher, by_value_handlers_copied_once_each)
+{
+    e->start();
+    const auto event_name = "EVENT_NAME";
+    const tc::sdk::event_dispatcher::handler_options synchronous{tc::sdk::event_dispatcher::delivery_mode::synchronous};
+    constexpr int by_value_handlers = 4;
+
+    // Every handler taking the payload by value gets its own copy of it, except the last one.
+    std::atomic<int> value_sum = 0;
+    for (int i = 0; i < by_value_handlers; ++i)
+        e->add_handler<copy_counted_payload>(event_name, [&value_sum](copy_counted_payload p) { value_sum += p.value; }, synchronous);
+
+    std::atomic<int> copies = 0;
+    EXPECT_TRUE(e->emit(event_name, copy_counted_payload(copies, 1)));
+    EXPECT_EQ(value_sum, by_value_handlers);
+    EXPECT_EQ(copies, by_value_handlers - 1);
+
+    // Queued handlers run concurrently: the last of them takes the payload only if the other ones are done with it.
+    std::latch sync(by_value_handlers);
+    auto channel = e->channel<copy_counted_payload>("QUEUED_EVENT_NAME");
+    for (int i = 0; i < by_value_handlers; ++i)
+    {
+        channel.add_handler([&sync, &value_sum](copy_counted_payload p) {
+            value_sum += p.value;
+            sync.count_down();
+        });
+    }
+
+    copies = 0;
+    EXPECT_TRUE(channel.emit(copy_counted_payload(copies, 1)));
+    sync.wait();
+    EXPECT_EQ(value_sum, 2 * by_value_handlers);
+    EXPECT_GE(copies, by_value_handlers - 1);
+    EXPECT_LE(copies, by_value_handlers);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_event_dispatcher, by_value_handler_with_shared_payload_handlers)
+{
+    e->start();
+    const auto event_name = "EVENT_NAME";
+    constexpr int queued_handlers = 4;
+
+    std::latch sync(queued_handlers + 1);
+    std::atomic<int> value_sum = 0;
+    for (int i = 0; i < queued_handlers; ++i)
+    {
+        e->add_handler<copy_counted_payload>(event_name, [&sync, &value_sum](const copy_counted_payload& p) {
+            value_sum += p.value;
+            sync.count_down();
+        });
+    }
+
+    e->add_handler<copy_counted_payload>(event_name, [&sync, &value_sum](copy_counted_payload p) {
+        value_sum += p.value;
+        sync.count_down();
+    });
+
+    // The by-value handler copies the payload only if the const reference handlers are still reading it.
+    std::atomic<int> copies = 0;
+    EXPECT_TRUE(e->emit(event_name, copy_counted_payload(copies, 2)));
+    sync.wait();
+    EXPECT_EQ(value_sum, 2 * (queued_handlers + 1));
+    EXPECT_LE(copies, 1);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_event_dispatcher, by_value_handler_last_reader)
+{
+    const tc::sdk::event_dispatcher::handler_options synchronous{tc::sdk::event_dispatcher::delivery_mode::synchronous};
+
+    // Synchronous handlers run in order: a by-value handler followed by another handler gets a copy, the last one takes the payload.
+    int first_value = 0;
+    e->add_handler<copy_counted_payload>("FIRST", [&first_value](copy_counted_payload p) { first_value = p.value; }, synchronous);
+    e->add_handler<copy_counted_payload>("FIRST", [](const copy_counted_payload&) {}, synchronous);
+
+    int last_value = 0;
+    e->add_handler<copy_counted_payload>("LAST", [](const copy_counted_payload&) {}, synchronous);
+    e->add_handler<copy_counted_payload>("LAST", [&last_value](copy_counted_payload p) { last_value = p.value; }, synchronous);
+
+    std::atomic<int> copies = 0;
+    EXPECT_TRUE(e->emit("FIRST", copy_counted_payload(copies, 7)));
+    EXPECT_EQ(first_value, 7);
+    EXPECT_EQ(copies, 1);
+
+    copies = 0;
+    EXPECT_TRUE(e->emit("LAST", copy_counted_payload(copies, 9)));
+    EXPECT_EQ(last_value, 9);
+    EXPECT_EQ(copies, 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_event_dispatcher_executor, start_stop)
+{
+    EXPECT_TRUE(e->start());
+    EXPECT_FALSE(e->start());
+
+    EXPECT_TRUE(e->stop());
+    EXPECT_FALSE(e->stop());
+
+    // The external executor is owned by the caller.
+    EXPECT_TRUE(tp.is_running());
+    EXPECT_EQ(tp.threads_count(), 1);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_event_dispatcher_executor, shared_executor)
+{
+    tc::sdk::event_dispatcher other(tp);
+    EXPECT_TRUE(e->start());
+    EXPECT_TRUE(other.start());
+
+    std::latch sync(3);
+    std::atomic<int> call_count{0};
+    std::vector<std::thread::id> thread_ids(2);
+
+    e->add_handler<int>("event", [&sync, &call_count, &thread_ids](int index) {
+        thread_ids[index] = std::this_thread::get_id();
+        ++call_count;
+        sync.count_down();
+    });
+    other.add_handler<int>("event", [&sync, &call_count, &thread_ids](int index) {
+        thread_ids[index] = std::this_thread::get_id();
+        ++call_count;
+        sync.count_down();
+    });
+
+    EXPECT_TRUE(e->emit("event", 0));
+    EXPECT_TRUE(other.emit("event", 1));
+    sync.arrive_and_wait();
+
+    EXPECT_EQ(call_count, 2);
+    EXPECT_NE(thread_ids[0], std::this_thread::get_id());
+    EXPECT_NE(thread_ids[1], std::this_thread::get_id());
+    EXPECT_EQ(tp.threads_count(), 1);
+
+    EXPECT_TRUE(other.stop());
+}
+
 }
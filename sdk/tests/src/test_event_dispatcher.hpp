@@ -18,8 +18,35 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+
 namespace tc::sdk::tests
 {
+// Event payload that counts how many times it has been copied.
+struct copy_counted_payload
+{
+    explicit copy_counted_payload(std::atomic<int>& copies, int value = 0)
+        : copy_count{&copies}
+        , value{value}
+    {
+    }
+
+    copy_counted_payload(const copy_counted_payload& other)
+        : copy_count{other.copy_count}
+        , value{other.value}
+    {
+        ++*copy_count;
+    }
+
+    copy_counted_payload(copy_counted_payload&&) noexcept = default;
+    copy_counted_payload& operator=(const copy_counted_payload&) = delete;
+    copy_counted_payload& operator=(copy_counted_payload&&) = delete;
+    ~copy_counted_payload() = default;
+
+    std::atomic<int>* copy_count;
+    int value;
+};
+
 class test_event_dispatcher : public ::testing::Test
 {
 protected:
@@ -36,4 +63,23 @@ protected:
     std::unique_ptr<tc::sdk::event_dispatcher> e;
 };
 
+class test_event_dispatcher_executor : public ::testing::Test
+{
+protected:
+    explicit test_event_dispatcher_executor()
+        : e{std::make_unique<tc::sdk::event_dispatcher>(tp)}
+    {
+        tp.start(1);
+    }
+
+    ~test_event_dispatcher_executor() override
+    {
+        e->stop();
+        tp.stop();
+    }
+
+    tc::sdk::thread_pool tp;
+    std::unique_ptr<tc::sdk::event_dispatcher> e;
+};
+
 }
@@ -279,4 +279,44 @@ TEST_F(test_high_precision_timer, DISABLED_TSAN_WARNING_reset_callback)
     }
 }
 
+// NOLINTNEXTLINE
+TEST(test_high_precision_timer_manual_clock, simulated_time)
+{
+    auto clock = std::make_shared<tc::sdk::manual_clock>();
+    tc::sdk::high_precision_timer timer(clock);
+
+    std::atomic<uint64_t> callback_count{0};
+    timer.set_callback([&callback_count] { ++callback_count; });
+    EXPECT_TRUE(timer.start(1s));
+
+    // One simulated day, with one callback per simulated second.
+    constexpr uint64_t seconds_count = 24 * 60 * 60;
+    for (uint64_t n = 0; n < seconds_count; ++n)
+    {
+        clock->advance(1s);
+        clock->wait_for_idle();
+    }
+
+    timer.stop();
+    EXPECT_EQ(callback_count, seconds_count);
+    EXPECT_EQ(timer.invoked_callback_count(), seconds_count);
+    EXPECT_EQ(timer.missed_callback_count(), 0);
+}
+
+// NOLINTNEXTLINE
+TEST(test_high_precision_timer_manual_clock, missed_callbacks)
+{
+    auto clock = std::make_shared<tc::sdk::manual_clock>();
+    tc::sdk::high_precision_timer timer(clock);
+
+    timer.set_callback([] {});
+    EXPECT_TRUE(timer.start(1s));
+
+    clock->advance(10s);
+    clock->wait_for_idle();
+
+    timer.stop();
+    EXPECT_EQ(timer.invoked_callback_count(), 1);
+    EXPECT_EQ(timer.missed_callback_count(), 9);
+}
 }
@@ -134,4 +134,33 @@ TEST(test_rate_limiter, sync_higher_delay)
     EXPECT_EQ(tick_counter, expected_ticks);
 }
 
+// NOLINTNEXTLINE
+TEST(test_rate_limiter, manual_clock)
+{
+    auto clock = std::make_shared<tc::sdk::manual_clock>();
+    // The frame duration is a floating point number of seconds: 1/8s is exactly representable.
+    const auto rate = 8;
+    tc::sdk::rate_limiter limiter(rate, clock);
+
+    std::atomic<int> tick_counter{0};
+    std::thread loop([&limiter, &tick_counter] {
+        for (auto n = 0; n < 100; ++n)
+        {
+            limiter.sync();
+            ++tick_counter;
+        }
+    });
+
+    // Each frame lasts 125ms of simulated time.
+    for (auto n = 1; n < 100; ++n)
+    {
+        clock->advance(125ms);
+        clock->wait_for_idle();
+        EXPECT_EQ(tick_counter, n);
+    }
+
+    clock->advance(125ms);
+    loop.join();
+    EXPECT_EQ(tick_counter, 100);
+}
 }
@@ -14,6 +14,9 @@
 
 #include "test_task.hpp"
 
+#include <array>
+#include <memory>
+#include <mutex>
 #include <thread>
 
 namespace tc::sdk::tests
@@ -243,4 +246,50 @@ TEST(test_task, parallel_invoke)
     EXPECT_EQ(task_invoked_count, total_invoke_count);
 }
 
+
+// NOLINTNEXTLINE
+TEST(test_task, inline_storage_move)
+{
+    auto payload = std::make_shared<int>(42);
+    int result = 0;
+
+    // The callable fits in the inline storage: moving the task moves the callable, without copying it.
+    auto t = tc::sdk::task([payload, &result] { result = *payload; });
+    EXPECT_EQ(payload.use_count(), 2);
+
+    auto t_move(std::move(t));
+    auto t_move_again(std::move(t_move));
+    EXPECT_EQ(payload.use_count(), 2);
+
+    t_move_again();
+    EXPECT_EQ(result, 42);
+}
+
+// NOLINTNEXTLINE
+TEST(test_task, heap_storage_move)
+{
+    std::array<char, 4 * tc::sdk::task::inline_storage_size> payload{};
+    payload.back() = 'x';
+    char result = 0;
+
+    auto t = tc::sdk::task([payload, &result] { result = payload.back(); });
+    auto t_move(std::move(t));
+    t_move();
+
+    EXPECT_EQ(result, 'x');
+}
+
+// NOLINTNEXTLINE
+TEST(test_task, destroy_callable)
+{
+    auto payload = std::make_shared<int>(0);
+
+    {
+        auto t = tc::sdk::task([payload] {});
+        auto t_move(std::move(t));
+        EXPECT_EQ(payload.use_count(), 2);
+    }
+
+    EXPECT_EQ(payload.use_count(), 1);
+}
 }
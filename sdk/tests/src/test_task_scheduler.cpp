@@ -14,6 +14,13 @@
 
 #include "test_task_scheduler.hpp"
 
+#include <algorithm>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <poll.h>
+#endif
+
 namespace tc::sdk::tests
 {
 // NOLINTNEXTLINE
@@ -279,6 +286,37 @@ TEST_F(test_task_scheduler, remove_last_scheduled_task)
 {
 }
 
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler, many_task_ids)
+{
+    constexpr int task_count = 10000;
+
+    EXPECT_TRUE(ts->start());
+
+    for (auto n = 0; n < task_count; ++n)
+        EXPECT_TRUE(ts->in("TASK_" + std::to_string(n), 1min, simple_task).has_value());
+
+    EXPECT_EQ(ts->tasks_size(), task_count);
+
+    for (auto n = 0; n < task_count; n += 2)
+    {
+        const auto task_id = "TASK_" + std::to_string(n);
+        EXPECT_TRUE(ts->is_scheduled(task_id));
+        EXPECT_TRUE(ts->set_enabled(task_id, false));
+        EXPECT_TRUE(ts->remove_task(task_id));
+        EXPECT_FALSE(ts->is_scheduled(task_id));
+    }
+
+    EXPECT_EQ(ts->tasks_size(), task_count / 2);
+
+    for (auto n = 1; n < task_count; n += 2)
+    {
+        const auto task_id = "TASK_" + std::to_string(n);
+        EXPECT_TRUE(ts->is_scheduled(task_id));
+        EXPECT_TRUE(ts->is_enabled(task_id));
+    }
+}
+
 ///////////////////////////////////////////////////////////
 // IN
 ///////////////////////////////////////////////////////////
@@ -682,4 +720,1426 @@ TEST_F(test_task_scheduler_every, self_removing)
     EXPECT_TRUE(is_executed());
     EXPECT_FALSE(is_pending());
 }
+
+///////////////////////////////////////////////////////////
+// HANDLE
+///////////////////////////////////////////////////////////
+class test_task_scheduler_handle : public test_task_scheduler_api
+{
+};
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_handle, invalid)
+{
+    ts->start();
+
+    const tc::sdk::task_scheduler::task_handle handle;
+    EXPECT_FALSE(handle.is_valid());
+    EXPECT_FALSE(ts->is_scheduled(handle));
+    EXPECT_FALSE(ts->is_enabled(handle));
+    EXPECT_FALSE(ts->set_enabled(handle, false));
+    EXPECT_FALSE(ts->remove_task(handle));
+    EXPECT_FALSE(ts->get_interval(handle).has_value());
+    EXPECT_FALSE(ts->update_interval(handle, 1s));
+    EXPECT_FALSE(ts->reschedule(handle, tc::sdk::clock::now()));
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_handle, not_running)
+{
+    EXPECT_FALSE(ts->every(1s, simple_task).is_valid());
+    EXPECT_FALSE(ts->in(1s, simple_task).has_value());
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_handle, bool_conversion)
+{
+    // The handle can be tested in a condition, but it does not silently convert to bool (nor to any arithmetic type).
+    static_assert(std::is_constructible_v<bool, tc::sdk::task_scheduler::task_handle>);
+    static_assert(!std::is_convertible_v<tc::sdk::task_scheduler::task_handle, bool>);
+    static_assert(!std::is_convertible_v<tc::sdk::task_scheduler::task_handle, int>);
+
+    EXPECT_FALSE(ts->every("task_id", 1s, simple_task));
+
+    ts->start();
+    const auto handle = ts->every("task_id", 1s, simple_task);
+    EXPECT_TRUE(handle);
+    EXPECT_FALSE(!handle);
+    EXPECT_FALSE(ts->every("task_id", 1s, simple_task));
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_handle, remove_anonymous_task)
+{
+    ts->start();
+
+    auto future = ts->in(1min, simple_task);
+    ASSERT_TRUE(future.has_value());
+
+    const auto handle = future->handle();
+    EXPECT_TRUE(handle.is_valid());
+    EXPECT_TRUE(ts->is_scheduled(handle));
+    EXPECT_TRUE(ts->is_enabled(handle));
+    EXPECT_FALSE(ts->get_interval(handle).has_value());
+
+    EXPECT_TRUE(ts->remove_task(handle));
+    EXPECT_FALSE(ts->is_scheduled(handle));
+    EXPECT_FALSE(ts->remove_task(handle));
+    EXPECT_EQ(ts->tasks_size(), 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_handle, expired_handle)
+{
+    ts->start();
+
+    auto old_handle = ts->every(1min, simple_task);
+    EXPECT_TRUE(ts->remove_task(old_handle));
+
+    // The slot of the removed task is reused by the new task, but the old handle must not refer to it.
+    auto new_handle = ts->every(1min, simple_task);
+    EXPECT_NE(old_handle, new_handle);
+    EXPECT_FALSE(ts->is_scheduled(old_handle));
+    EXPECT_FALSE(ts->set_enabled(old_handle, false));
+    EXPECT_TRUE(ts->is_scheduled(new_handle));
+    EXPECT_TRUE(ts->is_enabled(new_handle));
+
+    ts->stop();
+    ts->start();
+    EXPECT_FALSE(ts->is_scheduled(new_handle));
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_handle, one_shot_task_run)
+{
+    ts->start();
+
+    auto future = ts->in(1ms, task);
+    ASSERT_TRUE(future.has_value());
+    future->wait();
+
+    while (is_pending())
+        std::this_thread::sleep_for(1ms);
+
+    EXPECT_TRUE(is_executed());
+    EXPECT_FALSE(ts->is_scheduled(future->handle()));
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_handle, reschedule)
+{
+    ts->start();
+
+    auto future = ts->in(1h, task);
+    ASSERT_TRUE(future.has_value());
+    EXPECT_TRUE(ts->reschedule(future->handle(), tc::sdk::clock::now() + 1ms));
+
+    wait_execution();
+    EXPECT_TRUE(is_executed());
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_handle, recursive_task)
+{
+    ts->start();
+
+    auto handle = ts->every(1h, task);
+    EXPECT_TRUE(ts->set_enabled(handle, false));
+    EXPECT_FALSE(ts->is_enabled(handle));
+    EXPECT_TRUE(ts->set_enabled(handle, true));
+    EXPECT_TRUE(ts->is_enabled(handle));
+
+    EXPECT_EQ(ts->get_interval(handle), 1h);
+    EXPECT_TRUE(ts->update_interval(handle, 5ms));
+    EXPECT_EQ(ts->get_interval(handle), 5ms);
+
+    wait_execution();
+    EXPECT_TRUE(is_executed());
+    EXPECT_TRUE(ts->is_scheduled(handle));
+    EXPECT_TRUE(ts->remove_task(handle));
+    EXPECT_FALSE(is_pending());
+}
+
+///////////////////////////////////////////////////////////
+// OVERLAP POLICY
+///////////////////////////////////////////////////////////
+class test_task_scheduler_overlap : public test_task_scheduler
+{
+protected:
+    // Schedule a task slower than its interval, with a start delay so that the policy is set before the first run.
+    tc::sdk::task_scheduler::task_handle schedule_slow_task(std::optional<tc::sdk::task_scheduler::overlap_policy> policy)
+    {
+        auto handle = ts->every("SLOW_TASK", tc::sdk::task_scheduler::interval_t{2ms}, tc::sdk::task_scheduler::delay_t{10ms}, slow_task);
+        if (policy.has_value())
+        {
+            EXPECT_TRUE(ts->set_overlap_policy(handle, policy.value()));
+        }
+
+        return handle;
+    }
+
+    void wait_runs(int runs_count)
+    {
+        while (runs < runs_count)
+            std::this_thread::sleep_for(1ms);
+    }
+
+    std::atomic<int> runs{0};
+    std::atomic<int> running{0};
+    std::atomic<int> max_running{0};
+
+    std::function<void()> slow_task = [this] {
+        const auto current = ++running;
+        auto max = max_running.load();
+        while (current > max && !max_running.compare_exchange_weak(max, current))
+        {
+        }
+
+        std::this_thread::sleep_for(10ms);
+        --running;
+        ++runs;
+    };
+};
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_overlap, allow)
+{
+    ts->start(4);
+    auto handle = schedule_slow_task(std::nullopt);
+    wait_runs(5);
+
+    // Overlapping runs are all queued in the thread pool (the actual concurrency depends on the available threads).
+    const auto stats = ts->get_overlap_stats(handle);
+    EXPECT_TRUE(ts->remove_task(handle));
+
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->skipped_runs, 0);
+    EXPECT_EQ(stats->coalesced_runs, 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_overlap, skip)
+{
+    ts->start(4);
+    auto handle = schedule_slow_task(tc::sdk::task_scheduler::overlap_policy::skip);
+    wait_runs(5);
+
+    const auto stats = ts->get_overlap_stats(handle);
+    EXPECT_TRUE(ts->remove_task(handle));
+
+    EXPECT_EQ(max_running, 1);
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_GT(stats->skipped_runs, 0);
+    EXPECT_EQ(stats->coalesced_runs, 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_overlap, coalesce)
+{
+    ts->start(4);
+    auto handle = schedule_slow_task(tc::sdk::task_scheduler::overlap_policy::coalesce);
+    wait_runs(5);
+
+    const auto stats = ts->get_overlap_stats("SLOW_TASK");
+    EXPECT_TRUE(ts->remove_task(handle));
+
+    EXPECT_EQ(max_running, 1);
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->skipped_runs, 0);
+    EXPECT_GT(stats->coalesced_runs, 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_overlap, one_shot_task)
+{
+    ts->start();
+
+    auto future = ts->in(1min, simple_task);
+    ASSERT_TRUE(future.has_value());
+    EXPECT_FALSE(ts->set_overlap_policy(future->handle(), tc::sdk::task_scheduler::overlap_policy::skip));
+    EXPECT_FALSE(ts->get_overlap_stats(future->handle()).has_value());
+    EXPECT_FALSE(ts->set_overlap_policy("MISSING_TASK", tc::sdk::task_scheduler::overlap_policy::skip));
+}
+
+///////////////////////////////////////////////////////////
+// CONCURRENCY
+///////////////////////////////////////////////////////////
+class test_task_scheduler_concurrency : public test_task_scheduler
+{
+protected:
+    static constexpr int producers_count = 8;
+    static constexpr int tasks_per_producer = 1000;
+
+    void wait_empty()
+    {
+        while (ts->tasks_size() > 0)
+            std::this_thread::sleep_for(1ms);
+    }
+};
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_concurrency, producers)
+{
+    std::atomic<int> executed_tasks{0};
+    EXPECT_TRUE(ts->start(4));
+
+    std::vector<std::thread> producers;
+    for (auto p = 0; p < producers_count; ++p)
+    {
+        producers.emplace_back([this, p, &executed_tasks] {
+            for (auto n = 0; n < tasks_per_producer; ++n)
+            {
+                auto task = [&executed_tasks] { ++executed_tasks; };
+                if (n % 2 == 0)
+                    EXPECT_TRUE(ts->in(std::chrono::microseconds(n % 2000), task).has_value());
+                else
+                    EXPECT_TRUE(ts->in("TASK_" + std::to_string(p) + "_" + std::to_string(n), std::chrono::microseconds(n % 2000), task).has_value());
+            }
+        });
+    }
+
+    for (auto&& producer : producers)
+        producer.join();
+
+    // Expired tasks are no longer scheduled, but they may still be queued in the thread pool.
+    wait_empty();
+    while (executed_tasks < producers_count * tasks_per_producer)
+        std::this_thread::sleep_for(1ms);
+
+    EXPECT_EQ(executed_tasks, producers_count * tasks_per_producer);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_concurrency, remove_while_running)
+{
+    EXPECT_TRUE(ts->start(4));
+
+    std::vector<std::thread> producers;
+    for (auto p = 0; p < producers_count; ++p)
+    {
+        producers.emplace_back([this] {
+            for (auto n = 0; n < tasks_per_producer; ++n)
+            {
+                // Removal races with the task expiration: both outcomes are valid, but the task must not be pending anymore.
+                auto recurring = ts->every(tc::sdk::task_scheduler::interval_t{std::chrono::microseconds(100)}, [] {});
+                auto future = ts->in(std::chrono::microseconds(n % 100), [] {});
+                ASSERT_TRUE(future.has_value());
+
+                EXPECT_TRUE(ts->reschedule(recurring, tc::sdk::clock::now()));
+                EXPECT_TRUE(ts->remove_task(recurring));
+                EXPECT_FALSE(ts->is_scheduled(recurring));
+
+                ts->remove_task(future->handle());
+                EXPECT_FALSE(ts->is_scheduled(future->handle()));
+            }
+        });
+    }
+
+    for (auto&& producer : producers)
+        producer.join();
+
+    wait_empty();
+    EXPECT_EQ(ts->tasks_size(), 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_concurrency, stop_start_while_scheduling)
+{
+    // Producers keep scheduling and removing recurring tasks while the scheduler is repeatedly stopped and restarted:
+    // stop() waits for the producers that are writing their slots before clearing the tasks, so that no slot is lost or handed out twice.
+    EXPECT_TRUE(ts->start(2));
+
+    std::atomic<bool> is_producing{true};
+    std::vector<std::thread> producers;
+    for (auto p = 0; p < producers_count; ++p)
+    {
+        producers.emplace_back([this, &is_producing] {
+            while (is_producing)
+            {
+                if (auto handle = ts->every(tc::sdk::task_scheduler::interval_t{1ms}, [] {}); handle.is_valid())
+                    ts->remove_task(handle);
+            }
+        });
+    }
+
+    for (auto n = 0; n < 50; ++n)
+    {
+        std::this_thread::sleep_for(1ms);
+        EXPECT_TRUE(ts->stop());
+        EXPECT_EQ(ts->tasks_size(), 0);
+        EXPECT_TRUE(ts->start(2));
+    }
+
+    is_producing = false;
+    for (auto&& producer : producers)
+        producer.join();
+
+    EXPECT_TRUE(ts->stop());
+    EXPECT_EQ(ts->tasks_size(), 0);
+
+    // The released slots are all reusable: every new task gets its own slot and is run exactly once.
+    EXPECT_TRUE(ts->start(2));
+    constexpr int tasks_count = 500;
+    std::atomic<int> executed_tasks{0};
+    std::vector<tc::sdk::task_scheduler::task_handle> handles;
+    for (auto n = 0; n < tasks_count; ++n)
+    {
+        auto future = ts->in(std::chrono::microseconds(n % 1000), [&executed_tasks] { ++executed_tasks; });
+        ASSERT_TRUE(future.has_value());
+        EXPECT_EQ(std::count(handles.begin(), handles.end(), future->handle()), 0);
+        handles.push_back(future->handle());
+    }
+
+    wait_empty();
+    while (executed_tasks < tasks_count)
+        std::this_thread::sleep_for(1ms);
+
+    EXPECT_EQ(executed_tasks, tasks_count);
+}
+
+///////////////////////////////////////////////////////////
+// TIMING WHEEL
+///////////////////////////////////////////////////////////
+class test_task_scheduler_timing_wheel : public test_task_scheduler
+{
+protected:
+    // A small resolution makes the tasks scheduled within a few milliseconds span several levels of the wheel.
+    test_task_scheduler_timing_wheel()
+    {
+        ts = std::make_unique<tc::sdk::task_scheduler>(tc::sdk::task_scheduler::timer_backend::timing_wheel, 10us);
+    }
+};
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_timing_wheel, never_early)
+{
+    constexpr int task_count = 64;
+    std::latch sync{task_count};
+    std::atomic<int> early_tasks{0};
+
+    EXPECT_TRUE(ts->start());
+
+    for (auto n = 0; n < task_count; ++n)
+    {
+        // Delays from 0ms to 189ms: up to 18900 ticks, i.e. the third level of the wheel.
+        const auto timepoint = tc::sdk::clock::now() + std::chrono::milliseconds((n * 37) % 190);
+        EXPECT_TRUE(ts->at(tc::sdk::clock::time_point{timepoint}, [timepoint, &sync, &early_tasks] {
+                          if (tc::sdk::clock::now() < timepoint)
+                              ++early_tasks;
+
+                          sync.count_down();
+                      }).has_value());
+    }
+
+    sync.wait();
+    EXPECT_EQ(early_tasks, 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_timing_wheel, remove_and_reschedule)
+{
+    constexpr int task_count = 1000;
+
+    EXPECT_TRUE(ts->start());
+
+    for (auto n = 0; n < task_count; ++n)
+        EXPECT_TRUE(ts->in("TASK_" + std::to_string(n), 100ms + std::chrono::microseconds(n * 50), simple_task).has_value());
+
+    for (auto n = 0; n < task_count; n += 2)
+        EXPECT_TRUE(ts->remove_task("TASK_" + std::to_string(n)));
+
+    std::latch sync{3};
+    EXPECT_TRUE(ts->every("PERIODIC", 1h, [&sync] {
+        if (!sync.try_wait())
+            sync.count_down();
+    }));
+    EXPECT_TRUE(ts->update_interval("PERIODIC", 1ms));
+
+    sync.wait();
+    EXPECT_TRUE(ts->is_scheduled("PERIODIC"));
+
+    while (ts->tasks_size() > 1)
+        std::this_thread::sleep_for(5ms);
+
+    for (auto n = 0; n < task_count; ++n)
+        EXPECT_FALSE(ts->is_scheduled("TASK_" + std::to_string(n)));
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_timing_wheel, far_future)
+{
+    EXPECT_TRUE(ts->start());
+
+    // Far beyond the wheel span with a 10us resolution (about 19 hours).
+    EXPECT_TRUE(ts->in("TASK_ID", tc::sdk::task_scheduler::delay_t{std::chrono::hours(24 * 365)}, simple_task).has_value());
+    EXPECT_TRUE(ts->in(1ms, simple_task).has_value());
+
+    while (ts->tasks_size() > 1)
+        std::this_thread::sleep_for(1ms);
+
+    EXPECT_TRUE(ts->is_scheduled("TASK_ID"));
+    EXPECT_TRUE(ts->remove_task("TASK_ID"));
+    EXPECT_EQ(ts->tasks_size(), 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_calendar, never_matching_schedule)
+{
+    ts->start();
+
+    const auto schedule = tc::sdk::cron_schedule::from_string("0 0 30 2 *");
+    EXPECT_FALSE(ts->every(schedule, calendar_task).is_valid());
+    EXPECT_FALSE(ts->every("CALENDAR_TASK", schedule, calendar_task).is_valid());
+    EXPECT_EQ(ts->tasks_size(), 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_calendar, every_second)
+{
+    ts->start();
+
+    auto handle = ts->every("CALENDAR_TASK", tc::sdk::cron_schedule::from_string("* * * * * *"), calendar_task);
+    EXPECT_TRUE(handle.is_valid());
+    EXPECT_TRUE(ts->is_scheduled("CALENDAR_TASK"));
+
+    while (runs < 3)
+        std::this_thread::sleep_for(10ms);
+
+    EXPECT_TRUE(ts->remove_task(handle));
+
+    // Each run starts at a different second of the system clock.
+    std::scoped_lock lock(run_times_mtx);
+    for (size_t n = 1; n < run_times.size(); ++n)
+        EXPECT_NE(std::chrono::floor<std::chrono::seconds>(run_times[n]), std::chrono::floor<std::chrono::seconds>(run_times[n - 1]));
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_calendar, interval)
+{
+    ts->start();
+
+    auto handle = ts->every(tc::sdk::cron_schedule::from_string("@daily"), calendar_task);
+    EXPECT_TRUE(ts->is_scheduled(handle));
+    EXPECT_FALSE(ts->get_interval(handle).has_value());
+    EXPECT_FALSE(ts->update_interval(handle, 1ms));
+    EXPECT_TRUE(ts->set_overlap_policy(handle, tc::sdk::task_scheduler::overlap_policy::skip));
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_calendar, reschedule)
+{
+    ts->start();
+
+    auto handle = ts->every(tc::sdk::cron_schedule::from_string("@yearly"), calendar_task);
+    EXPECT_TRUE(ts->reschedule(handle, tc::sdk::clock::now() + 10ms));
+
+    while (runs < 1)
+        std::this_thread::sleep_for(1ms);
+
+    // The task follows its schedule again after the rescheduled run.
+    std::this_thread::sleep_for(50ms);
+    EXPECT_EQ(runs, 1);
+    EXPECT_TRUE(ts->is_scheduled(handle));
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_slack, default_slack)
+{
+    EXPECT_EQ(ts->get_timer_slack(), tc::sdk::clock::duration{0});
+
+    ts->set_timer_slack(5ms);
+    EXPECT_EQ(ts->get_timer_slack(), 5ms);
+
+    ts->set_timer_slack(-5ms);
+    EXPECT_EQ(ts->get_timer_slack(), tc::sdk::clock::duration{0});
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_slack, invalid_task)
+{
+    ts->start();
+
+    EXPECT_FALSE(ts->set_timer_slack("TASK_ID", 10ms));
+    EXPECT_FALSE(ts->set_timer_slack(tc::sdk::task_scheduler::task_handle{}, 10ms));
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_slack, batched_start_times)
+{
+    ts->start();
+
+    constexpr auto slack = std::chrono::milliseconds(100);
+    ts->set_timer_slack(slack);
+
+    // The start times are rounded up to the slack window, so all the tasks inside a window are run together.
+    const auto now = tc::sdk::clock::now();
+    std::vector<std::pair<tc::sdk::clock::time_point, std::future<tc::sdk::clock::time_point>>> tasks;
+    for (auto n = 1; n <= 10; ++n)
+    {
+        const auto timepoint = now + n * 1ms;
+        tasks.emplace_back(timepoint, schedule_at(timepoint));
+    }
+
+    for (auto&& [timepoint, run_time] : tasks)
+        EXPECT_GE(run_time.get(), round_up(timepoint, slack));
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_slack, task_slack)
+{
+    ts->start();
+
+    constexpr auto slack = std::chrono::milliseconds(200);
+    const auto timepoint = tc::sdk::clock::now() + 50ms;
+    auto future = ts->at(tc::sdk::clock::time_point{timepoint}, [] { return tc::sdk::clock::now(); });
+    ASSERT_TRUE(future.has_value());
+
+    // The pending task is moved to the end of its slack window.
+    EXPECT_TRUE(ts->set_timer_slack(future->handle(), slack));
+    EXPECT_GE(future->get(), round_up(timepoint, slack));
+
+    // Tasks without their own slack are not delayed.
+    auto other_future = schedule_at(tc::sdk::clock::now() + 1ms);
+    EXPECT_EQ(other_future.wait_for(slack / 2), std::future_status::ready);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_slack, recurring_task)
+{
+    ts->start();
+
+    constexpr auto slack = std::chrono::milliseconds(20);
+    constexpr auto duration = std::chrono::milliseconds(200);
+    ts->set_timer_slack(slack);
+
+    // Without any slack the task would run about 40 times.
+    std::atomic<int> runs{0};
+    auto handle = ts->every(tc::sdk::task_scheduler::interval_t{5ms}, [&runs] { ++runs; });
+    std::this_thread::sleep_for(duration);
+    EXPECT_TRUE(ts->remove_task(handle));
+    ts->stop();
+
+    // The task runs at most once per slack window.
+    EXPECT_GT(runs, 0);
+    EXPECT_LE(runs, duration / slack + 1);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_phase, phase_spreading)
+{
+    EXPECT_EQ(ts->get_phase_spreading(), tc::sdk::task_scheduler::phase_spreading::none);
+
+    ts->set_phase_spreading(tc::sdk::task_scheduler::phase_spreading::hash);
+    EXPECT_EQ(ts->get_phase_spreading(), tc::sdk::task_scheduler::phase_spreading::hash);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_phase, jitter)
+{
+    ts->set_phase_spreading(tc::sdk::task_scheduler::phase_spreading::jitter);
+    ts->start();
+
+    EXPECT_GT(first_runs_span(), interval / 4);
+    EXPECT_LT(ts->get_dispatch_stats().max_tasks_per_tick, tasks_count);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_phase, hash)
+{
+    ts->set_phase_spreading(tc::sdk::task_scheduler::phase_spreading::hash);
+    ts->start();
+
+    EXPECT_GT(first_runs_span(), interval / 4);
+    EXPECT_LT(ts->get_dispatch_stats().max_tasks_per_tick, tasks_count);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_phase, dispatch_stats)
+{
+    ts->start();
+
+    const auto timepoint = tc::sdk::clock::now() + 20ms;
+    std::vector<std::future<void>> futures;
+    for (auto n = 0; n < 5; ++n)
+        futures.push_back(std::move(ts->at(tc::sdk::clock::time_point{timepoint}, [] {}).value()));
+
+    for (auto&& future : futures)
+        future.wait();
+
+    ts->stop();
+
+    const auto stats = ts->get_dispatch_stats();
+    EXPECT_EQ(stats.dispatched_tasks, 5);
+    EXPECT_GE(stats.ticks, 1);
+    EXPECT_LE(stats.ticks, 5);
+    EXPECT_GE(stats.wakeups, stats.ticks);
+    EXPECT_LE(stats.max_tasks_per_tick, 5);
+
+    uint64_t histogram_ticks = 0;
+    for (auto&& ticks : stats.tasks_per_tick)
+        histogram_ticks += ticks;
+    EXPECT_EQ(histogram_ticks, stats.ticks);
+
+    ts->reset_dispatch_stats();
+    const auto reset_stats = ts->get_dispatch_stats();
+    EXPECT_EQ(reset_stats.wakeups, 0);
+    EXPECT_EQ(reset_stats.ticks, 0);
+    EXPECT_EQ(reset_stats.dispatched_tasks, 0);
+    EXPECT_EQ(reset_stats.max_tasks_per_tick, 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_stats, disabled)
+{
+    ts->start();
+    EXPECT_FALSE(ts->is_task_stats_enabled());
+
+    auto handle = ts->every("TASK_ID", tc::sdk::task_scheduler::interval_t{1h}, [] {});
+    EXPECT_FALSE(ts->get_task_stats(handle).has_value());
+    EXPECT_FALSE(ts->get_task_stats("TASK_ID").has_value());
+    EXPECT_FALSE(ts->get_task_stats(tc::sdk::task_scheduler::task_handle{}).has_value());
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_stats, pending_task)
+{
+    ts->set_task_stats_enabled(true);
+    EXPECT_TRUE(ts->is_task_stats_enabled());
+    ts->start();
+
+    auto future = ts->in("TASK_ID", 1h, [] {});
+    ASSERT_TRUE(future.has_value());
+
+    const auto stats = ts->get_task_stats("TASK_ID");
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->lateness.count, 0);
+    EXPECT_EQ(stats->duration.count, 0);
+    EXPECT_EQ(stats->missed_periods, 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_stats, recurring_task)
+{
+    ts->set_task_stats_enabled(true);
+    ts->start();
+
+    auto handle = ts->every(tc::sdk::task_scheduler::interval_t{10ms}, [] { std::this_thread::sleep_for(2ms); });
+    const auto stats = wait_stats(handle, 5);
+    EXPECT_TRUE(ts->remove_task(handle));
+
+    EXPECT_GE(stats.duration.count, 5);
+    EXPECT_GE(stats.duration.max, 2ms);
+    EXPECT_GE(stats.duration.mean(), 2ms);
+    EXPECT_GE(stats.duration.percentile(0.5), 2ms);
+    EXPECT_EQ(buckets_sum(stats.duration), stats.duration.count);
+
+    EXPECT_GE(stats.lateness.count, 5);
+    EXPECT_EQ(buckets_sum(stats.lateness), stats.lateness.count);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_stats, missed_periods)
+{
+    ts->set_task_stats_enabled(true);
+    ts->start();
+
+    // A timer slack much larger than the interval makes the task miss most of its periods.
+    auto handle = ts->every(tc::sdk::task_scheduler::interval_t{2ms}, [] {});
+    EXPECT_TRUE(ts->set_timer_slack(handle, 50ms));
+    const auto stats = wait_stats(handle, 3);
+    EXPECT_TRUE(ts->remove_task(handle));
+
+    EXPECT_GT(stats.missed_periods, 0);
+    EXPECT_GE(stats.lateness.max, 2ms);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_stats, histogram)
+{
+    tc::sdk::task_scheduler::duration_histogram histogram;
+    EXPECT_EQ(histogram.mean(), tc::sdk::clock::duration{0});
+    EXPECT_EQ(histogram.percentile(0.5), tc::sdk::clock::duration{0});
+
+    // 3 durations below 1us, 1 duration of about 100us.
+    histogram.count = 4;
+    histogram.total = 100us;
+    histogram.max = 100us;
+    histogram.buckets[0] = 3;
+    histogram.buckets[7] = 1;
+
+    EXPECT_EQ(histogram.mean(), 25us);
+    EXPECT_EQ(histogram.percentile(0.5), 1us);
+    EXPECT_EQ(histogram.percentile(0.9), 100us);
+    EXPECT_EQ(histogram.percentile(1.0), 100us);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_manual_clock, simulated_week)
+{
+    ts->start(1);
+
+    std::atomic<uint64_t> runs{0};
+    ts->every(tc::sdk::task_scheduler::interval_t{1min}, [&runs] { ++runs; });
+    while (runs < 1)
+        std::this_thread::sleep_for(1ms);
+
+    // One simulated week, with one run per simulated minute.
+    constexpr uint64_t minutes_count = 7 * 24 * 60;
+    for (uint64_t n = 0; n < minutes_count; ++n)
+    {
+        clock->advance(1min);
+        clock->wait_for_idle();
+    }
+
+    while (runs < minutes_count + 1)
+        std::this_thread::sleep_for(1ms);
+
+    EXPECT_EQ(runs, minutes_count + 1);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_manual_clock, one_shot_task)
+{
+    ts->start(1);
+
+    auto future = ts->in(1h, [] { return 42; });
+    ASSERT_TRUE(future.has_value());
+    clock->wait_for_idle();
+
+    clock->advance(59min);
+    clock->wait_for_idle();
+    EXPECT_EQ(future->wait_for(10ms), std::future_status::timeout);
+
+    clock->advance(1min);
+    EXPECT_EQ(future->get(), 42);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_manual_clock, calendar_task)
+{
+    ts->start(1);
+
+    // The manual clock starts at 2024-05-01T00:00:00 (UTC).
+    std::atomic<int> runs{0};
+    ts->every(tc::sdk::cron_schedule::from_string("0 12 * * MON-FRI"), [&runs] { ++runs; });
+    clock->wait_for_idle();
+
+    // May 2024 has 23 week days.
+    for (auto day = 0; day < 31; ++day)
+    {
+        clock->advance(24h);
+        clock->wait_for_idle();
+    }
+
+    while (runs < 23)
+        std::this_thread::sleep_for(1ms);
+
+    std::this_thread::sleep_for(10ms);
+    EXPECT_EQ(runs, 23);
+}
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_executor, start_stop)
+{
+    EXPECT_TRUE(ts->start());
+    EXPECT_FALSE(ts->start());
+
+    EXPECT_TRUE(ts->stop());
+    EXPECT_FALSE(ts->stop());
+
+    // The external executor is owned by the caller.
+    EXPECT_TRUE(tp.is_running());
+    EXPECT_EQ(tp.threads_count(), 1);
+
+    EXPECT_TRUE(ts->start());
+    std::promise<void> p;
+    ts->in(std::chrono::milliseconds(1), [&p] { p.set_value(); });
+    EXPECT_EQ(p.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_executor, shared_executor)
+{
+    tc::sdk::task_scheduler other(tp, tc::sdk::task_scheduler::timer_backend::timing_wheel);
+    EXPECT_TRUE(ts->start());
+    EXPECT_TRUE(other.start());
+
+    std::latch sync(3);
+    std::atomic<int> runs{0};
+    auto task = [&sync, &runs] {
+        if (++runs <= 2)
+            sync.count_down();
+    };
+
+    ts->in(std::chrono::milliseconds(1), task);
+    other.in(std::chrono::milliseconds(1), task);
+    sync.arrive_and_wait();
+
+    EXPECT_EQ(runs, 2);
+    EXPECT_EQ(tp.threads_count(), 1);
+    EXPECT_TRUE(other.stop());
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_executor, stop_waits_dispatched_tasks)
+{
+    EXPECT_TRUE(ts->start());
+
+    std::promise<void> started;
+    std::atomic<bool> completed{false};
+    ts->in(std::chrono::milliseconds(1), [&started, &completed] {
+        started.set_value();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        completed = true;
+    });
+
+    started.get_future().wait();
+    EXPECT_TRUE(ts->stop());
+    EXPECT_TRUE(completed);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_timerfd, set_wakeup_backend)
+{
+    if (!is_supported)
+        GTEST_SKIP() << "timerfd is not available on this platform";
+
+    EXPECT_EQ(ts->get_wakeup_backend(), tc::sdk::task_scheduler::wakeup_backend::timerfd);
+    EXPECT_GE(ts->native_handle(), 0);
+
+    EXPECT_TRUE(ts->start());
+    EXPECT_FALSE(ts->set_wakeup_backend(tc::sdk::task_scheduler::wakeup_backend::condition_variable));
+    EXPECT_TRUE(ts->stop());
+
+    EXPECT_TRUE(ts->set_wakeup_backend(tc::sdk::task_scheduler::wakeup_backend::condition_variable));
+    EXPECT_EQ(ts->get_wakeup_backend(), tc::sdk::task_scheduler::wakeup_backend::condition_variable);
+    EXPECT_EQ(ts->native_handle(), -1);
+    EXPECT_FALSE(ts->start_polled());
+
+    // The timerfd deadlines cannot follow a virtual clock.
+    tc::sdk::task_scheduler manual_ts(std::make_shared<tc::sdk::manual_clock>());
+    EXPECT_FALSE(manual_ts.set_wakeup_backend(tc::sdk::task_scheduler::wakeup_backend::timerfd));
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_timerfd, in)
+{
+    if (!is_supported)
+        GTEST_SKIP() << "timerfd is not available on this platform";
+
+    EXPECT_TRUE(ts->start());
+
+    const auto delay = std::chrono::milliseconds(20);
+    const auto start_time = tc::sdk::clock::now();
+    std::promise<tc::sdk::clock::time_point> p;
+    ts->in(delay, [&p] { p.set_value(tc::sdk::clock::now()); });
+
+    auto f = p.get_future();
+    ASSERT_EQ(f.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_GE(f.get() - start_time, delay);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_timerfd, every)
+{
+    if (!is_supported)
+        GTEST_SKIP() << "timerfd is not available on this platform";
+
+    EXPECT_TRUE(ts->start());
+
+    std::latch sync(11);
+    std::atomic<int> runs{0};
+    ts->every(std::chrono::milliseconds(2), [&sync, &runs] {
+        if (++runs <= 10)
+            sync.count_down();
+    });
+
+    // A task scheduled far in the future must not delay the recurring one.
+    ts->in(std::chrono::hours(1), [] {});
+    sync.arrive_and_wait();
+
+    EXPECT_GE(runs, 10);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_timerfd, start_polled)
+{
+    if (!is_supported)
+        GTEST_SKIP() << "timerfd is not available on this platform";
+
+    EXPECT_TRUE(ts->start_polled());
+    EXPECT_FALSE(ts->start());
+
+    std::atomic<int> runs{0};
+    ts->in(std::chrono::milliseconds(5), [&runs] { ++runs; });
+    ts->in(std::chrono::milliseconds(10), [&runs] { ++runs; });
+
+#if defined(__linux__)
+    // The event loop of the caller drives the scheduler.
+    const auto deadline = tc::sdk::clock::now() + std::chrono::seconds(5);
+    while (ts->tasks_size() > 0 && tc::sdk::clock::now() < deadline)
+    {
+        pollfd fd{ts->native_handle(), POLLIN, 0};
+        if (::poll(&fd, 1, 1000) > 0)
+            ts->poll();
+    }
+#endif
+
+    EXPECT_EQ(ts->tasks_size(), 0);
+
+    for (auto n = 0; runs < 2 && n < 5000; ++n)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    EXPECT_EQ(runs, 2);
+    EXPECT_TRUE(ts->stop());
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_coroutine, sleep_for)
+{
+    EXPECT_TRUE(ts->start(1));
+
+    const auto delay = std::chrono::milliseconds(20);
+    std::promise<tc::sdk::clock::duration> p;
+    [](tc::sdk::task_scheduler& ts, std::promise<tc::sdk::clock::duration>& p, tc::sdk::clock::duration delay) -> coroutine {
+        const auto start_time = tc::sdk::clock::now();
+        co_await ts.sleep_for(delay);
+        p.set_value(tc::sdk::clock::now() - start_time);
+    }(*ts, p, delay);
+
+    auto f = p.get_future();
+    ASSERT_EQ(f.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_GE(f.get(), delay);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_coroutine, sleep_until)
+{
+    EXPECT_TRUE(manual_ts->start(1));
+
+    std::promise<tc::sdk::clock::time_point> p;
+    [](tc::sdk::task_scheduler& ts, std::promise<tc::sdk::clock::time_point>& p) -> coroutine {
+        co_await ts.sleep_until(tc::sdk::clock::time_point{std::chrono::hours(1)});
+        p.set_value(ts.get_clock()->now());
+    }(*manual_ts, p);
+
+    clock->advance(std::chrono::minutes(59));
+    clock->wait_for_idle();
+    clock->advance(std::chrono::minutes(1));
+
+    auto f = p.get_future();
+    ASSERT_EQ(f.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(f.get(), tc::sdk::clock::time_point{std::chrono::hours(1)});
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_coroutine, sleep_not_running)
+{
+    // The coroutine is not suspended when the scheduler is not running: the sleep is cancelled.
+    bool is_resumed = false;
+    bool is_elapsed = true;
+    [](tc::sdk::task_scheduler& ts, bool& is_resumed, bool& is_elapsed) -> coroutine {
+        is_elapsed = co_await ts.sleep_for(std::chrono::hours(1));
+        is_resumed = true;
+    }(*ts, is_resumed, is_elapsed);
+
+    EXPECT_TRUE(is_resumed);
+    EXPECT_FALSE(is_elapsed);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_coroutine, sleep_stopped)
+{
+    EXPECT_TRUE(manual_ts->start(1));
+
+    // The coroutines suspended when the scheduler is stopped are resumed as cancelled, and they complete:
+    // their frames (and the locals they hold) are not leaked.
+    const auto coroutines_count = 100;
+    auto token = std::make_shared<int>(0);
+    std::atomic<int> cancelled_count{0};
+    for (auto n = 0; n < coroutines_count; ++n)
+    {
+        [](tc::sdk::task_scheduler& ts, std::shared_ptr<int>, std::atomic<int>& cancelled_count) -> coroutine {
+            if (!co_await ts.sleep_for(std::chrono::hours(1)))
+                ++cancelled_count;
+        }(*manual_ts, token, cancelled_count);
+    }
+
+    EXPECT_EQ(token.use_count(), coroutines_count + 1);
+    EXPECT_TRUE(manual_ts->stop());
+    EXPECT_EQ(cancelled_count, coroutines_count);
+    EXPECT_EQ(token.use_count(), 1);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_coroutine, many_suspended_coroutines)
+{
+    EXPECT_TRUE(manual_ts->start(1));
+
+    // Thousands of coroutines sleep for up to 100 simulated hours without blocking any thread.
+    const auto coroutines_count = 10000;
+    std::latch done(coroutines_count);
+    std::atomic<int> late_resumes{0};
+    for (auto n = 0; n < coroutines_count; ++n)
+    {
+        [](tc::sdk::task_scheduler& ts, std::latch& done, std::atomic<int>& late_resumes, tc::sdk::clock::duration delay) -> coroutine {
+            const auto deadline = ts.get_clock()->now() + delay;
+            co_await ts.sleep_for(delay);
+            if (ts.get_clock()->now() < deadline)
+                ++late_resumes;
+
+            done.count_down();
+        }(*manual_ts, done, late_resumes, std::chrono::hours(1 + n % 100));
+    }
+
+    EXPECT_EQ(manual_ts->tasks_size(), coroutines_count);
+    for (auto n = 0; n < 100; ++n)
+    {
+        clock->advance(std::chrono::hours(1));
+        clock->wait_for_idle();
+    }
+
+    done.wait();
+    EXPECT_EQ(late_resumes, 0);
+    EXPECT_EQ(manual_ts->tasks_size(), 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_coroutine, with_timeout_expired)
+{
+    EXPECT_TRUE(manual_ts->start(1));
+
+    std::promise<std::optional<bool>> p;
+    [](tc::sdk::task_scheduler& ts, std::promise<std::optional<bool>>& p) -> coroutine {
+        p.set_value(co_await ts.with_timeout(ts.sleep_for(std::chrono::seconds(10)), std::chrono::seconds(1)));
+    }(*manual_ts, p);
+
+    clock->wait_for_idle();
+    clock->advance(std::chrono::seconds(1));
+
+    auto f = p.get_future();
+    ASSERT_EQ(f.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_FALSE(f.get().has_value());
+
+    // The operation is not cancelled: it completes in the background.
+    EXPECT_EQ(manual_ts->tasks_size(), 1);
+    clock->wait_for_idle();
+    clock->advance(std::chrono::seconds(9));
+    for (auto n = 0; manual_ts->tasks_size() > 0 && n < 5000; ++n)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    EXPECT_EQ(manual_ts->tasks_size(), 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_coroutine, with_timeout_completed)
+{
+    EXPECT_TRUE(ts->start(1));
+
+    std::promise<std::optional<bool>> p;
+    [](tc::sdk::task_scheduler& ts, std::promise<std::optional<bool>>& p) -> coroutine {
+        p.set_value(co_await ts.with_timeout(ts.sleep_for(std::chrono::milliseconds(10)), std::chrono::hours(1)));
+    }(*ts, p);
+
+    auto f = p.get_future();
+    ASSERT_EQ(f.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(f.get(), std::optional<bool>(true));
+
+    // The timeout timer is removed as soon as the operation completes.
+    for (auto n = 0; ts->tasks_size() > 0 && n < 5000; ++n)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    EXPECT_EQ(ts->tasks_size(), 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_coroutine, with_timeout_stopped)
+{
+    EXPECT_TRUE(manual_ts->start(1));
+
+    std::coroutine_handle<> operation;
+    std::optional<bool> result;
+    [](tc::sdk::task_scheduler& ts, std::optional<bool>& result, std::coroutine_handle<>& operation) -> coroutine {
+        result = co_await ts.with_timeout(never_awaitable{operation}, std::chrono::hours(1));
+    }(*manual_ts, result, operation);
+
+    // The waiting coroutine is resumed by stop() as if the timeout expired.
+    ASSERT_TRUE(operation);
+    EXPECT_FALSE(result.has_value());
+    EXPECT_TRUE(manual_ts->stop());
+    EXPECT_EQ(result, std::optional<bool>(false));
+
+    operation.destroy();
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_coroutine, with_timeout_not_running)
+{
+    // Without a running scheduler the timeout cannot be armed: the operation is not started.
+    std::coroutine_handle<> operation;
+    std::optional<bool> result;
+    [](tc::sdk::task_scheduler& ts, std::optional<bool>& result, std::coroutine_handle<>& operation) -> coroutine {
+        result = co_await ts.with_timeout(never_awaitable{operation}, std::chrono::hours(1));
+    }(*ts, result, operation);
+
+    EXPECT_EQ(result, std::optional<bool>(false));
+    EXPECT_FALSE(operation);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_coroutine, with_timeout_result)
+{
+    struct value_awaitable
+    {
+        int value;
+
+        bool await_ready() const noexcept
+        {
+            return true;
+        }
+
+        void await_suspend(std::coroutine_handle<>) const noexcept
+        {
+        }
+
+        int await_resume() const
+        {
+            if (value < 0)
+                throw std::runtime_error("negative value");
+
+            return value;
+        }
+    };
+
+    EXPECT_TRUE(ts->start(1));
+
+    std::promise<std::optional<int>> p;
+    [](tc::sdk::task_scheduler& ts, std::promise<std::optional<int>>& p) -> coroutine {
+        p.set_value(co_await ts.with_timeout(value_awaitable{42}, std::chrono::hours(1)));
+    }(*ts, p);
+
+    auto f = p.get_future();
+    ASSERT_EQ(f.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(f.get(), std::optional<int>(42));
+
+    std::promise<std::exception_ptr> e;
+    [](tc::sdk::task_scheduler& ts, std::promise<std::exception_ptr>& e) -> coroutine {
+        try
+        {
+            co_await ts.with_timeout(value_awaitable{-1}, std::chrono::hours(1));
+            e.set_value(nullptr);
+        }
+        catch (...)
+        {
+            e.set_value(std::current_exception());
+        }
+    }(*ts, e);
+
+    EXPECT_THROW(std::rethrow_exception(e.get_future().get()), std::runtime_error);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_retry, not_running)
+{
+    EXPECT_FALSE(ts->retry({}, [] { return 0; }).has_value());
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_retry, success_after_failures)
+{
+    EXPECT_TRUE(ts->start(1));
+
+    tc::sdk::task_scheduler::retry_policy policy;
+    policy.initial_delay = std::chrono::milliseconds(1);
+
+    std::atomic<int> attempts{0};
+    auto future = ts->retry(policy, [&attempts] {
+        if (++attempts < 3)
+            throw std::runtime_error("failure");
+
+        return 42;
+    });
+
+    ASSERT_TRUE(future.has_value());
+    ASSERT_EQ(future->wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(future->get(), 42);
+    EXPECT_EQ(attempts, 3);
+    EXPECT_FALSE(ts->is_scheduled(future->handle()));
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_retry, max_attempts)
+{
+    EXPECT_TRUE(ts->start(1));
+
+    tc::sdk::task_scheduler::retry_policy policy;
+    policy.max_attempts = 4;
+    policy.initial_delay = std::chrono::milliseconds(1);
+
+    std::atomic<int> attempts{0};
+    auto future = ts->retry(policy, [&attempts] {
+        ++attempts;
+        throw std::runtime_error("failure");
+    });
+
+    ASSERT_TRUE(future.has_value());
+    ASSERT_EQ(future->wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_THROW(future->get(), std::runtime_error);
+    EXPECT_EQ(attempts, 4);
+    EXPECT_FALSE(ts->is_scheduled(future->handle()));
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_retry, predicate)
+{
+    EXPECT_TRUE(ts->start(1));
+
+    tc::sdk::task_scheduler::retry_policy policy;
+    policy.max_attempts = 10;
+    policy.initial_delay = std::chrono::milliseconds(1);
+
+    // Only std::runtime_error failures are retried.
+    std::atomic<int> attempts{0};
+    auto future = ts->retry(
+        policy,
+        [&attempts] {
+            if (++attempts < 3)
+                throw std::runtime_error("transient failure");
+
+            throw std::logic_error("permanent failure");
+        },
+        [](const std::exception_ptr& error) {
+            try
+            {
+                std::rethrow_exception(error);
+            }
+            catch (const std::runtime_error&)
+            {
+                return true;
+            }
+            catch (...)
+            {
+                return false;
+            }
+        });
+
+    ASSERT_TRUE(future.has_value());
+    ASSERT_EQ(future->wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_THROW(future->get(), std::logic_error);
+    EXPECT_EQ(attempts, 3);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_retry, exponential_backoff)
+{
+    EXPECT_TRUE(ts->start(1));
+
+    tc::sdk::task_scheduler::retry_policy policy;
+    policy.max_attempts = 5;
+    policy.initial_delay = std::chrono::milliseconds(5);
+    policy.multiplier = 2.0;
+    policy.max_delay = std::chrono::milliseconds(20);
+
+    std::vector<tc::sdk::clock::time_point> attempt_times;
+    auto future = ts->retry(policy, [&attempt_times] {
+        attempt_times.push_back(tc::sdk::clock::now());
+        throw std::runtime_error("failure");
+    });
+
+    ASSERT_TRUE(future.has_value());
+    ASSERT_EQ(future->wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_THROW(future->get(), std::runtime_error);
+
+    // Attempts never start before their backoff delay: 5ms, 10ms, then capped to 20ms.
+    const std::vector<tc::sdk::clock::duration> delays = {std::chrono::milliseconds(5), std::chrono::milliseconds(10), std::chrono::milliseconds(20), std::chrono::milliseconds(20)};
+    ASSERT_EQ(attempt_times.size(), delays.size() + 1);
+    for (size_t n = 0; n < delays.size(); ++n)
+        EXPECT_GE(attempt_times[n + 1] - attempt_times[n], delays[n]);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_retry, jitter)
+{
+    EXPECT_TRUE(ts->start(1));
+
+    tc::sdk::task_scheduler::retry_policy policy;
+    policy.max_attempts = 3;
+    policy.initial_delay = std::chrono::milliseconds(10);
+    policy.jitter = 0.5;
+
+    std::vector<tc::sdk::clock::time_point> attempt_times;
+    auto future = ts->retry(policy, [&attempt_times] {
+        attempt_times.push_back(tc::sdk::clock::now());
+        throw std::runtime_error("failure");
+    });
+
+    ASSERT_TRUE(future.has_value());
+    ASSERT_EQ(future->wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_THROW(future->get(), std::runtime_error);
+
+    // Each delay is randomized in [delay * (1 - jitter), delay].
+    ASSERT_EQ(attempt_times.size(), 3);
+    EXPECT_GE(attempt_times[1] - attempt_times[0], std::chrono::milliseconds(5));
+    EXPECT_GE(attempt_times[2] - attempt_times[1], std::chrono::milliseconds(10));
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_retry, deadline)
+{
+    EXPECT_TRUE(ts->start(1));
+
+    tc::sdk::task_scheduler::retry_policy policy;
+    policy.max_attempts = 0;
+    policy.initial_delay = std::chrono::milliseconds(10);
+    policy.multiplier = 1.0;
+    policy.deadline = std::chrono::milliseconds(55);
+
+    std::atomic<int> attempts{0};
+    const auto start_time = tc::sdk::clock::now();
+    auto future = ts->retry(policy, [&attempts] {
+        ++attempts;
+        throw std::runtime_error("failure");
+    });
+
+    ASSERT_TRUE(future.has_value());
+    ASSERT_EQ(future->wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_THROW(future->get(), std::runtime_error);
+
+    // No attempt starts after the deadline, so at most one attempt every 10ms in 55ms.
+    EXPECT_GE(attempts, 1);
+    EXPECT_LE(attempts, 6);
+    EXPECT_GE(tc::sdk::clock::now() - start_time, std::chrono::milliseconds(10) * (attempts - 1));
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_retry, cancel)
+{
+    EXPECT_TRUE(ts->start(1));
+
+    tc::sdk::task_scheduler::retry_policy policy;
+    policy.max_attempts = 0;
+    policy.initial_delay = std::chrono::hours(1);
+
+    std::promise<void> first_attempt;
+    std::atomic<int> attempts{0};
+    auto future = ts->retry(policy, [&attempts, &first_attempt] {
+        if (++attempts == 1)
+            first_attempt.set_value();
+
+        throw std::runtime_error("failure");
+    });
+
+    ASSERT_TRUE(future.has_value());
+    first_attempt.get_future().wait();
+
+    // Wait for the second attempt to be armed, one hour later.
+    for (auto n = 0; ts->get_dispatch_stats().wakeups < 2 && n < 5000; ++n)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    EXPECT_TRUE(ts->remove_task(future->handle()));
+    ASSERT_EQ(future->wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_ANY_THROW(future->get());
+    EXPECT_EQ(attempts, 1);
+    EXPECT_EQ(ts->tasks_size(), 0);
+}
+
 }
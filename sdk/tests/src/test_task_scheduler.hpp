@@ -16,6 +16,8 @@
 
 #include <teiacare/sdk/task_scheduler.hpp>
 
+#include <coroutine>
+#include <exception>
 #include <gtest/gtest.h>
 #include <latch>
 
@@ -109,4 +111,239 @@ private:
     std::chrono::milliseconds sleep_time{2};
 };
 
+class test_task_scheduler_calendar : public test_task_scheduler
+{
+protected:
+    std::atomic<int> runs{0};
+    std::vector<tc::sdk::sys_time_point> run_times;
+    std::mutex run_times_mtx;
+
+    std::function<void()> calendar_task = [this] {
+        {
+            std::scoped_lock lock(run_times_mtx);
+            run_times.push_back(std::chrono::system_clock::now());
+        }
+        ++runs;
+    };
+};
+
+class test_task_scheduler_slack : public test_task_scheduler
+{
+protected:
+    static tc::sdk::clock::time_point round_up(tc::sdk::clock::time_point timepoint, tc::sdk::clock::duration slack)
+    {
+        const auto remainder = timepoint.time_since_epoch() % slack;
+        return remainder == tc::sdk::clock::duration{0} ? timepoint : timepoint + (slack - remainder);
+    }
+
+    // Schedule a one-shot task returning the time it has been run at.
+    std::future<tc::sdk::clock::time_point> schedule_at(tc::sdk::clock::time_point timepoint)
+    {
+        auto future = ts->at(tc::sdk::clock::time_point{timepoint}, [] { return tc::sdk::clock::now(); });
+        EXPECT_TRUE(future.has_value());
+        return std::move(future.value());
+    }
+};
+
+class test_task_scheduler_phase : public test_task_scheduler
+{
+protected:
+    static constexpr int tasks_count = 16;
+    static constexpr auto interval = std::chrono::milliseconds(400);
+
+    // Schedule the recursive tasks all together, returning the time span of their first runs.
+    tc::sdk::clock::duration first_runs_span()
+    {
+        std::array<std::atomic<tc::sdk::clock::rep>, tasks_count> first_runs{};
+        std::atomic<int> runs{0};
+
+        for (auto n = 0; n < tasks_count; ++n)
+        {
+            ts->every("TASK_" + std::to_string(n), tc::sdk::task_scheduler::interval_t{interval}, [&first_runs, &runs, n] {
+                tc::sdk::clock::rep expected = 0;
+                if (first_runs[n].compare_exchange_strong(expected, tc::sdk::clock::now().time_since_epoch().count()))
+                    ++runs;
+            });
+        }
+
+        while (runs < tasks_count)
+            std::this_thread::sleep_for(1ms);
+
+        ts->stop();
+
+        const auto [min, max] = std::minmax_element(first_runs.begin(), first_runs.end(), [](auto&& a, auto&& b) { return a.load() < b.load(); });
+        return tc::sdk::clock::duration{max->load() - min->load()};
+    }
+};
+
+class test_task_scheduler_stats : public test_task_scheduler
+{
+protected:
+    // Wait until the task has recorded the given number of runs.
+    tc::sdk::task_scheduler::task_stats wait_stats(tc::sdk::task_scheduler::task_handle handle, uint64_t runs_count)
+    {
+        while (true)
+        {
+            auto stats = ts->get_task_stats(handle);
+            EXPECT_TRUE(stats.has_value());
+            if (!stats.has_value() || stats->duration.count >= runs_count)
+                return stats.value_or(tc::sdk::task_scheduler::task_stats{});
+
+            std::this_thread::sleep_for(1ms);
+        }
+    }
+
+    static uint64_t buckets_sum(const tc::sdk::task_scheduler::duration_histogram& histogram)
+    {
+        uint64_t sum = 0;
+        for (auto&& count : histogram.buckets)
+            sum += count;
+
+        return sum;
+    }
+};
+
+class test_task_scheduler_manual_clock : public ::testing::Test
+{
+protected:
+    test_task_scheduler_manual_clock()
+        : clock{std::make_shared<tc::sdk::manual_clock>(tc::sdk::clock::time_point{}, tc::sdk::sys_time_point{std::chrono::sys_days{2024y / std::chrono::May / 1d}})}
+        , ts{std::make_unique<tc::sdk::task_scheduler>(clock)}
+    {
+    }
+
+    ~test_task_scheduler_manual_clock() override
+    {
+        ts->stop();
+    }
+
+    std::shared_ptr<tc::sdk::manual_clock> clock;
+    std::unique_ptr<tc::sdk::task_scheduler> ts;
+};
+
+class test_task_scheduler_executor : public ::testing::Test
+{
+protected:
+    test_task_scheduler_executor()
+        : ts{std::make_unique<tc::sdk::task_scheduler>(tp)}
+    {
+        tp.start(1);
+    }
+
+    ~test_task_scheduler_executor() override
+    {
+        ts->stop();
+        tp.stop();
+    }
+
+    tc::sdk::thread_pool tp;
+    std::unique_ptr<tc::sdk::task_scheduler> ts;
+};
+
+class test_task_scheduler_timerfd : public ::testing::Test
+{
+protected:
+    test_task_scheduler_timerfd()
+        : ts{std::make_unique<tc::sdk::task_scheduler>()}
+        , is_supported{ts->set_wakeup_backend(tc::sdk::task_scheduler::wakeup_backend::timerfd)}
+    {
+    }
+
+    ~test_task_scheduler_timerfd() override
+    {
+        ts->stop();
+    }
+
+    std::unique_ptr<tc::sdk::task_scheduler> ts;
+    const bool is_supported;
+};
+
+class test_task_scheduler_coroutine : public ::testing::Test
+{
+protected:
+    // Eagerly started coroutine: the tests report its results through std::promise objects.
+    struct coroutine
+    {
+        struct promise_type
+        {
+            coroutine get_return_object() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never final_suspend() noexcept
+            {
+                return {};
+            }
+
+            void return_void() noexcept
+            {
+            }
+
+            void unhandled_exception() noexcept
+            {
+                std::terminate();
+            }
+        };
+    };
+
+    // Operation that never completes: the test destroys the suspended coroutine awaiting it.
+    struct never_awaitable
+    {
+        std::coroutine_handle<>& suspended;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> coroutine) const noexcept
+        {
+            suspended = coroutine;
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+
+    test_task_scheduler_coroutine()
+        : clock{std::make_shared<tc::sdk::manual_clock>()}
+        , ts{std::make_unique<tc::sdk::task_scheduler>()}
+        , manual_ts{std::make_unique<tc::sdk::task_scheduler>(clock)}
+    {
+    }
+
+    ~test_task_scheduler_coroutine() override
+    {
+        ts->stop();
+        manual_ts->stop();
+    }
+
+    std::shared_ptr<tc::sdk::manual_clock> clock;
+    std::unique_ptr<tc::sdk::task_scheduler> ts;
+    std::unique_ptr<tc::sdk::task_scheduler> manual_ts;
+};
+
+class test_task_scheduler_retry : public ::testing::Test
+{
+protected:
+    test_task_scheduler_retry()
+        : ts{std::make_unique<tc::sdk::task_scheduler>()}
+    {
+    }
+
+    ~test_task_scheduler_retry() override
+    {
+        ts->stop();
+    }
+
+    std::unique_ptr<tc::sdk::task_scheduler> ts;
+};
+
 }
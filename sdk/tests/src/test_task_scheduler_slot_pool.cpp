@@ -0,0 +1,153 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "test_task_scheduler_slot_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace tc::sdk::tests
+{
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_slot_pool, empty)
+{
+    EXPECT_EQ(pool->size(), 0);
+    EXPECT_EQ(pool->find(0), nullptr);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_slot_pool, allocate)
+{
+    for (uint32_t n = 0; n < 10; ++n)
+    {
+        const auto index = pool->allocate();
+        ASSERT_TRUE(index.has_value());
+        EXPECT_EQ(*index, n);
+        EXPECT_EQ(pool->size(), n + 1);
+
+        // Slots are default constructed.
+        ASSERT_NE(pool->find(*index), nullptr);
+        EXPECT_EQ(*pool->find(*index), 0);
+    }
+
+    EXPECT_EQ(pool->find(10), nullptr);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_slot_pool, slots_never_move)
+{
+    // Allocate enough slots to span several chunks: the slots of the first chunks are not moved by the following allocations.
+    constexpr uint32_t slots_count = 10 * tc::sdk::detail::slot_pool<int>::first_chunk_size;
+    std::vector<int*> slots;
+    for (uint32_t n = 0; n < slots_count; ++n)
+    {
+        const auto index = pool->allocate();
+        ASSERT_TRUE(index.has_value());
+        (*pool)[*index] = static_cast<int>(n);
+        slots.push_back(pool->find(*index));
+    }
+
+    for (uint32_t n = 0; n < slots_count; ++n)
+    {
+        EXPECT_EQ(pool->find(n), slots[n]);
+        EXPECT_EQ(*slots[n], static_cast<int>(n));
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_slot_pool, release)
+{
+    const auto index_1 = pool->allocate();
+    const auto index_2 = pool->allocate();
+    ASSERT_TRUE(index_1.has_value() && index_2.has_value());
+    (*pool)[*index_1] = 1;
+
+    // Released slots are reused (most recently released first) and keep their value, while the pool does not grow.
+    pool->release(*index_2);
+    pool->release(*index_1);
+    EXPECT_EQ(pool->allocate(), index_1);
+    EXPECT_EQ((*pool)[*index_1], 1);
+    EXPECT_EQ(pool->allocate(), index_2);
+    EXPECT_EQ(pool->size(), 2);
+
+    EXPECT_EQ(pool->allocate(), 2);
+    EXPECT_EQ(pool->size(), 3);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_task_scheduler_slot_pool, concurrent_allocate_release)
+{
+    // Each thread repeatedly allocates a batch of slots, checks that no other thread owns them and releases them:
+    // a slot handed out twice (e.g. because of an ABA on the free list) is detected by the ownership flag.
+    constexpr int threads_count = 4;
+    constexpr int iterations = 1000;
+    constexpr int batch_size = 16;
+
+    auto owners = std::make_unique<tc::sdk::detail::slot_pool<std::atomic<int>>>();
+    std::atomic<int> errors = 0;
+    std::barrier sync(threads_count);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threads_count; ++t)
+    {
+        threads.emplace_back([&owners, &errors, &sync, t] {
+            sync.arrive_and_wait();
+            std::vector<uint32_t> batch;
+            for (int i = 0; i < iterations; ++i)
+            {
+                for (int n = 0; n < batch_size; ++n)
+                {
+                    const auto index = owners->allocate();
+                    if (!index.has_value() || (*owners)[*index].exchange(t + 1) != 0)
+                        ++errors;
+                    else
+                        batch.push_back(*index);
+                }
+
+                for (const auto index : batch)
+                {
+                    (*owners)[index].store(0);
+                    owners->release(index);
+                }
+
+                batch.clear();
+            }
+        });
+    }
+
+    for (auto&& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(errors, 0);
+    EXPECT_LE(owners->size(), threads_count * batch_size);
+
+    // Every slot is in the free list exactly once.
+    std::set<uint32_t> indices;
+    for (uint32_t n = 0; n < owners->size(); ++n)
+    {
+        const auto index = owners->allocate();
+        ASSERT_TRUE(index.has_value());
+        EXPECT_TRUE(indices.insert(*index).second);
+    }
+
+    // Then the free list is empty and the pool grows.
+    const auto size = owners->size();
+    EXPECT_EQ(indices.size(), size);
+    EXPECT_EQ(owners->allocate(), size);
+}
+
+}
@@ -0,0 +1,40 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "task_scheduler/slot_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+namespace tc::sdk::tests
+{
+class test_task_scheduler_slot_pool : public testing::Test
+{
+protected:
+    explicit test_task_scheduler_slot_pool()
+        : pool{std::make_unique<tc::sdk::detail::slot_pool<int>>()}
+    {
+    }
+
+    ~test_task_scheduler_slot_pool() override
+    {
+    }
+
+    std::unique_ptr<tc::sdk::detail::slot_pool<int>> pool;
+};
+
+}
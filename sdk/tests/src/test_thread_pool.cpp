@@ -161,6 +161,31 @@ TEST_F(test_thread_pool, run)
     EXPECT_EQ(counter, sync.max());
 }
 
+// NOLINTNEXTLINE
+TEST_F(test_thread_pool, execute)
+{
+    EXPECT_TRUE(tp->start(max_threads_count));
+    constexpr int task_count = 1024;
+    std::counting_semaphore<task_count> sync(0);
+
+    // Enqueue more tasks than the initial task queue capacity, so that it grows while workers are running.
+    std::atomic_int counter = 0;
+    for (auto i = 0; i < task_count; ++i)
+    {
+        tp->execute([&sync, &counter] {
+            ++counter;
+            sync.release();
+        });
+    }
+
+    for (auto i = 0; i < task_count; ++i)
+    {
+        sync.acquire();
+    }
+
+    EXPECT_EQ(counter, task_count);
+}
+
 TEST_F(test_thread_pool, run_with_return)
 {
     using namespace std::chrono_literals;
@@ -223,4 +248,35 @@ TEST_F(test_thread_pool, run_with_return_and_args)
     EXPECT_EQ(counter, sync.max());
 }
 
+// NOLINTNEXTLINE
+TEST_F(test_thread_pool, stats)
+{
+    EXPECT_TRUE(tp->start(1));
+
+    std::binary_semaphore is_blocked{0};
+    auto blocked_task = tp->run([&is_blocked] { is_blocked.acquire(); });
+    auto tasks = std::vector<std::future<int>>{};
+    for (int i = 0; i < 4; ++i)
+        tasks.emplace_back(tp->run([i] { return i; }));
+
+    is_blocked.release();
+    blocked_task.wait();
+    for (auto&& t : tasks)
+        t.wait();
+
+    const auto stats = tp->stats();
+    EXPECT_EQ(stats.push_blocked_time, tc::sdk::clock::duration::zero());
+    if constexpr (tc::sdk::queue_stats_enabled)
+    {
+        EXPECT_EQ(stats.push_count, 5);
+        EXPECT_EQ(stats.pop_count, 5);
+        EXPECT_GE(stats.peak_size, 4);
+        EXPECT_GT(stats.pop_blocked_time, tc::sdk::clock::duration::zero());
+    }
+    else
+    {
+        EXPECT_EQ(stats.push_count, 0);
+        EXPECT_EQ(stats.pop_count, 0);
+    }
+}
 }
@@ -0,0 +1,135 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "test_throttler.hpp"
+
+#include <atomic>
+
+namespace tc::sdk::tests
+{
+// NOLINTNEXTLINE
+TEST_F(test_throttler, scheduler_not_running)
+{
+    tc::sdk::task_scheduler stopped_ts;
+    tc::sdk::throttler throttler(stopped_ts, 100ms, [] {});
+
+    EXPECT_FALSE(throttler.trigger());
+    EXPECT_FALSE(throttler.is_pending());
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_throttler, leading_edge)
+{
+    std::atomic<int> calls{0};
+    tc::sdk::throttler throttler(ts, 100ms, [&calls] { ++calls; });
+
+    // The first event is handled without waiting for the period.
+    EXPECT_TRUE(throttler.trigger());
+    EXPECT_TRUE(eventually([&calls] { return calls == 1; }));
+    EXPECT_FALSE(throttler.is_pending());
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_throttler, trailing_edge)
+{
+    std::atomic<int> calls{0};
+    tc::sdk::throttler throttler(ts, 100ms, [&calls] { ++calls; });
+
+    EXPECT_TRUE(throttler.trigger());
+    ASSERT_TRUE(eventually([&calls] { return calls == 1; }));
+
+    // The events triggered within the period are coalesced in a single call at the end of the period.
+    for (auto n = 0; n < 10; ++n)
+        EXPECT_TRUE(throttler.trigger());
+
+    EXPECT_TRUE(throttler.is_pending());
+    clock->advance(50ms);
+    clock->wait_for_idle();
+    std::this_thread::sleep_for(10ms);
+    EXPECT_EQ(calls, 1);
+
+    clock->advance(50ms);
+    EXPECT_TRUE(eventually([&calls] { return calls == 2; }));
+    EXPECT_FALSE(throttler.is_pending());
+
+    clock->advance(1h);
+    clock->wait_for_idle();
+    std::this_thread::sleep_for(10ms);
+    EXPECT_EQ(calls, 2);
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_throttler, rate)
+{
+    std::atomic<int> calls{0};
+    tc::sdk::throttler throttler(ts, 100ms, [&calls] { ++calls; });
+
+    EXPECT_TRUE(throttler.trigger());
+    ASSERT_TRUE(eventually([&calls] { return calls == 1; }));
+
+    // One event every 10ms for one second: one call at the end of each period.
+    for (auto n = 1; n <= 100; ++n)
+    {
+        EXPECT_TRUE(throttler.trigger());
+        clock->advance(10ms);
+        clock->wait_for_idle();
+
+        // Let the due call start before the next event: the period starts when the call is run, so it must not depend on the thread pool latency.
+        if (n % 10 == 0)
+        {
+            EXPECT_TRUE(eventually([&calls, n] { return calls == 1 + n / 10; }));
+        }
+    }
+
+    EXPECT_EQ(calls, 11);
+    EXPECT_FALSE(throttler.is_pending());
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_throttler, idle_period)
+{
+    std::atomic<int> calls{0};
+    tc::sdk::throttler throttler(ts, 100ms, [&calls] { ++calls; });
+
+    EXPECT_TRUE(throttler.trigger());
+    ASSERT_TRUE(eventually([&calls] { return calls == 1; }));
+
+    // Once the period is over the next event is handled immediately again.
+    clock->advance(1s);
+    clock->wait_for_idle();
+
+    EXPECT_TRUE(throttler.trigger());
+    EXPECT_TRUE(eventually([&calls] { return calls == 2; }));
+}
+
+// NOLINTNEXTLINE
+TEST_F(test_throttler, destroy_pending)
+{
+    std::atomic<int> calls{0};
+    {
+        tc::sdk::throttler throttler(ts, 100ms, [&calls] { ++calls; });
+        EXPECT_TRUE(throttler.trigger());
+        ASSERT_TRUE(eventually([&calls] { return calls == 1; }));
+        EXPECT_TRUE(throttler.trigger());
+        EXPECT_TRUE(throttler.is_pending());
+    }
+
+    clock->advance(1s);
+    clock->wait_for_idle();
+    std::this_thread::sleep_for(10ms);
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(ts.tasks_size(), 0);
+}
+
+}
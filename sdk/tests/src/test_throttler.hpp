@@ -0,0 +1,64 @@
+// Copyright 2024 TeiaCare
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <teiacare/sdk/clock_source.hpp>
+#include <teiacare/sdk/throttler.hpp>
+#include <teiacare/sdk/task_scheduler.hpp>
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace tc::sdk::tests
+{
+class test_throttler : public ::testing::Test
+{
+protected:
+    test_throttler()
+        : clock{std::make_shared<tc::sdk::manual_clock>()}
+        , ts{clock}
+    {
+        ts.start(1);
+    }
+
+    ~test_throttler() override
+    {
+        ts.stop();
+    }
+
+    // Callbacks run on the scheduler thread pool: wait (in real time) until the expected state has been reached.
+    template <typename Predicate>
+    static bool eventually(Predicate&& predicate)
+    {
+        for (auto n = 0; n < 5000; ++n)
+        {
+            if (predicate())
+                return true;
+
+            std::this_thread::sleep_for(1ms);
+        }
+
+        return predicate();
+    }
+
+    std::shared_ptr<tc::sdk::manual_clock> clock;
+    tc::sdk::task_scheduler ts;
+};
+
+}